@@ -0,0 +1,49 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/AdaptiveReader.hpp"
+
+namespace exqudens::usb {
+
+    // 64 KiB bursts, the hand-picked 1024 byte reads split each burst into 64 transfers
+    static std::shared_ptr<IClient> createBurstClient() {
+        SimulatedTransport::Options options = {};
+        options.source = [](uint8_t endpoint, int32_t length) { return std::vector<uint8_t>(64 << 10, 0x55); };
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        client->open(client->listDevices().front());
+        return client;
+    }
+
+    static void readFixed(benchmark::State& state) {
+        std::shared_ptr<IClient> client = createBurstClient();
+        uint64_t bytes = 0;
+        uint64_t reads = 0;
+        for (auto _ : state) {
+            bytes += client->bulkRead(0x81, 100, 1024, false).size();
+            reads++;
+        }
+        state.SetBytesProcessed((int64_t) bytes);
+        state.counters["readsPerBurst"] = (double) reads / ((double) bytes / (64 << 10));
+    }
+
+    static void readAdaptive(benchmark::State& state) {
+        std::shared_ptr<IClient> client = createBurstClient();
+        AdaptiveReader reader(client, 0x81);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(reader.read().data());
+        }
+        AdaptiveReader::Stats stats = reader.getStats();
+        state.SetBytesProcessed((int64_t) stats.bytes);
+        state.counters["readsPerBurst"] = (double) stats.reads / ((double) stats.bytes / (64 << 10));
+        state.counters["readSize"] = (double) stats.readSize;
+    }
+
+    BENCHMARK(readFixed)->Name("AdaptiveReader.readFixed");
+    BENCHMARK(readAdaptive)->Name("AdaptiveReader.readAdaptive");
+
+}
@@ -0,0 +1,283 @@
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    static std::shared_ptr<IClient> createOpenClient(const SimulatedTransport::Options& options) {
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        client->open(client->listDevices().front());
+        return client;
+    }
+
+    static void bulkWrite(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t> {}; };
+        std::shared_ptr<IClient> client = createOpenClient(options);
+        std::vector<uint8_t> value((size_t) state.range(0), 0x55);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(client->bulkWrite(value, 1, 1000));
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0));
+    }
+
+    static void bulkRead(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        std::vector<uint8_t> data((size_t) state.range(0), 0x55);
+        options.source = [&data](uint8_t endpoint, int32_t length) { return data; };
+        std::shared_ptr<IClient> client = createOpenClient(options);
+        int32_t size = (int32_t) state.range(0);
+        for (auto _ : state) {
+            std::vector<uint8_t> value = client->bulkRead(1, 1000, size);
+            benchmark::DoNotOptimize(value.data());
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0));
+    }
+
+    static void bulkWriteRead(benchmark::State& state) {
+        std::shared_ptr<IClient> client = createOpenClient({});
+        std::vector<uint8_t> value((size_t) state.range(0), 0x55);
+        int32_t size = (int32_t) state.range(0);
+        for (auto _ : state) {
+            client->bulkWrite(value, 1, 1000);
+            std::vector<uint8_t> result = client->bulkRead(1, 1000, size);
+            benchmark::DoNotOptimize(result.data());
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0) * 2);
+    }
+
+    static void bulkWriteReadTyped(benchmark::State& state) {
+        std::shared_ptr<IClient> client = createOpenClient({});
+        std::vector<uint8_t> value((size_t) state.range(0), 0x55);
+        int32_t size = (int32_t) state.range(0);
+        for (auto _ : state) {
+            client->bulkWrite<Endpoint<1, Out, Bulk>>(value, 1000);
+            std::vector<uint8_t> result = client->bulkRead<Endpoint<1, In, Bulk>>(1000, size);
+            benchmark::DoNotOptimize(result.data());
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0) * 2);
+    }
+
+    static void bulkWriteBuffer(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t> {}; };
+        std::shared_ptr<IClient> client = createOpenClient(options);
+        Buffer value = client->allocateBuffer((size_t) state.range(0));
+        value.setSize((size_t) state.range(0));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(client->bulkWrite(value, 1, 1000));
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0));
+    }
+
+    static void bulkReadBuffer(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        std::vector<uint8_t> data((size_t) state.range(0), 0x55);
+        options.source = [&data](uint8_t endpoint, int32_t length) { return data; };
+        std::shared_ptr<IClient> client = createOpenClient(options);
+        Buffer value = client->allocateBuffer((size_t) state.range(0));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(client->bulkRead(value, 1, 1000));
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0));
+    }
+
+    static void bulkReadDeadline(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        std::vector<uint8_t> data((size_t) state.range(0), 0x55);
+        options.source = [&data](uint8_t endpoint, int32_t length) { return data; };
+        std::shared_ptr<IClient> client = createOpenClient(options);
+        std::shared_ptr<CancellationToken> token = std::make_shared<CancellationToken>();
+        int32_t size = (int32_t) state.range(0);
+        for (auto _ : state) {
+            std::vector<uint8_t> value = client->bulkRead(1, std::chrono::steady_clock::now() + std::chrono::seconds(1), size, token);
+            benchmark::DoNotOptimize(value.data());
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0));
+    }
+
+    static void bulkReadError(benchmark::State& state) {
+        std::shared_ptr<IClient> client = createOpenClient({});
+        for (auto _ : state) {
+            try {
+                // endpoint '2' is not configured, the transfer fails without waiting
+                benchmark::DoNotOptimize(client->bulkRead(2, 1000, 64));
+            } catch (const std::exception& e) {
+                benchmark::DoNotOptimize(e.what());
+            }
+        }
+    }
+
+    static void bulkReadTimeout(benchmark::State& state) {
+        std::shared_ptr<IClient> client = createOpenClient({});
+        for (auto _ : state) {
+            try {
+                benchmark::DoNotOptimize(client->bulkRead(1, 1, 64));
+            } catch (const std::exception& e) {
+                benchmark::DoNotOptimize(e.what());
+            }
+        }
+    }
+
+    static void listDevices(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        for (auto _ : state) {
+            std::vector<std::map<std::string, uint16_t>> devices = client->listDevices();
+            benchmark::DoNotOptimize(devices.data());
+        }
+        state.counters["devices"] = (double) state.range(0);
+    }
+
+    static void listDevicesFilter(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        DeviceFilter filter = {};
+        filter.portPath = {1};
+        for (auto _ : state) {
+            std::vector<std::map<std::string, uint16_t>> devices = client->listDevices(filter);
+            benchmark::DoNotOptimize(devices.data());
+        }
+    }
+
+    static void openClose(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        std::map<std::string, uint16_t> device = client->listDevices().back();
+        for (auto _ : state) {
+            client->open(device);
+            client->close();
+        }
+        state.counters["devices"] = (double) state.range(0);
+    }
+
+    static void toString(benchmark::State& state) {
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared({});
+        std::map<std::string, uint16_t> device = client->listDevices().front();
+        for (auto _ : state) {
+            std::string value = client->toString(device);
+            benchmark::DoNotOptimize(value.data());
+        }
+    }
+
+    static void log(benchmark::State& state) {
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared({});
+        if (state.range(0) != 0) {
+            client->setLogFunction([](
+                const std::string& file,
+                size_t line,
+                const std::string& function,
+                const std::string& id,
+                uint16_t level,
+                const std::string& message
+            ) {
+                benchmark::DoNotOptimize(message.data());
+            });
+        }
+        for (auto _ : state) {
+            // 'getVersion' writes one debug message
+            std::string value = client->getVersion();
+            benchmark::DoNotOptimize(value.data());
+        }
+    }
+
+    static void bulkReadSpin(benchmark::State& state) {
+        std::shared_ptr<SimulatedTransport> transport = std::make_shared<SimulatedTransport>();
+        std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+        client->open(client->listDevices().front());
+        transport->setSpinBudget((uint32_t) state.range(0));
+        std::atomic<bool> stopped = false;
+        std::atomic<size_t> requested = 0;
+        // responses come from another thread, so the read has to wait for them
+        std::thread producer([&transport, &stopped, &requested]() {
+            size_t produced = 0;
+            uint8_t value = 0x55;
+            int32_t transferred = 0;
+            while (!stopped) {
+                if (produced < requested.load()) {
+                    transport->bulkTransfer(1, &value, 1, &transferred, 1000, nullptr);
+                    produced++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        for (auto _ : state) {
+            requested++;
+            benchmark::DoNotOptimize(client->bulkRead(1, 1000, 64));
+        }
+        stopped = true;
+        producer.join();
+        ITransport::PollStats stats = transport->getPollStats();
+        state.counters["spinHits"] = (double) stats.spinHits;
+        state.counters["spinMisses"] = (double) stats.spinMisses;
+    }
+
+    static void loadDescriptorCache(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        std::string path = (std::filesystem::temp_directory_path() / "exqudens-usb-descriptors.bin").generic_string();
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        for (const std::map<std::string, uint16_t>& device : client->listDevices()) {
+            client->getStringDescriptor(device, StringDescriptor::MANUFACTURER);
+            client->getStringDescriptor(device, StringDescriptor::PRODUCT);
+            client->getStringDescriptor(device, StringDescriptor::SERIAL_NUMBER);
+        }
+        client->saveDescriptorCache(path);
+        for (auto _ : state) {
+            std::shared_ptr<IClient> restarted = ClientFactory::createSimulatedShared(options);
+            benchmark::DoNotOptimize(restarted->loadDescriptorCache(path));
+        }
+        std::filesystem::remove(path);
+    }
+
+    static void reconnect(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t> {}; };
+        std::shared_ptr<SimulatedTransport> transport = std::make_shared<SimulatedTransport>(options);
+        std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+        client->setReconnect(1000);
+        client->open(client->listDevices().front());
+        std::vector<uint8_t> value(8, 0x55);
+        for (auto _ : state) {
+            transport->disconnect(0);
+            transport->connect(0);
+            benchmark::DoNotOptimize(client->bulkWrite(value, 1, 1000));
+        }
+    }
+
+    BENCHMARK(bulkWrite)->Name("Client.bulkWrite")->RangeMultiplier(8)->Range(8, 64 << 10);
+    BENCHMARK(bulkRead)->Name("Client.bulkRead")->RangeMultiplier(8)->Range(8, 64 << 10);
+    BENCHMARK(bulkWriteRead)->Name("Client.bulkWriteRead")->RangeMultiplier(8)->Range(8, 64 << 10);
+    BENCHMARK(bulkWriteReadTyped)->Name("Client.bulkWriteReadTyped")->RangeMultiplier(8)->Range(8, 64 << 10);
+    BENCHMARK(bulkWriteBuffer)->Name("Client.bulkWriteBuffer")->RangeMultiplier(8)->Range(8, 64 << 10);
+    BENCHMARK(bulkReadBuffer)->Name("Client.bulkReadBuffer")->RangeMultiplier(8)->Range(8, 64 << 10);
+    BENCHMARK(bulkReadDeadline)->Name("Client.bulkReadDeadline")->RangeMultiplier(8)->Range(8, 64 << 10);
+    BENCHMARK(bulkReadError)->Name("Client.bulkReadError");
+    BENCHMARK(bulkReadTimeout)->Name("Client.bulkReadTimeout")->Unit(benchmark::kMillisecond);
+    BENCHMARK(listDevices)->Name("Client.listDevices")->RangeMultiplier(4)->Range(1, 256);
+    BENCHMARK(listDevicesFilter)->Name("Client.listDevicesFilter")->RangeMultiplier(4)->Range(1, 256);
+    BENCHMARK(openClose)->Name("Client.openClose")->RangeMultiplier(4)->Range(1, 256);
+    BENCHMARK(bulkReadSpin)->Name("Client.bulkReadSpin")->ArgName("spinBudget")->Arg(0)->Arg(100)->UseRealTime();
+    BENCHMARK(loadDescriptorCache)->Name("Client.loadDescriptorCache")->RangeMultiplier(4)->Range(1, 256);
+    BENCHMARK(reconnect)->Name("Client.reconnect");
+    BENCHMARK(toString)->Name("Client.toString");
+    BENCHMARK(log)->Name("Client.log")->ArgName("logFunction")->Arg(0)->Arg(1);
+
+}
@@ -0,0 +1,44 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <map>
+#include <memory>
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    static void acquire(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        std::shared_ptr<ClientPool> pool = ClientFactory::createPoolShared(
+            [&options]() { return ClientFactory::createSimulatedShared(options); },
+            std::chrono::milliseconds(60000)
+        );
+        std::map<std::string, uint16_t> device = ClientFactory::createSimulatedShared(options)->listDevices().back();
+        for (auto _ : state) {
+            ClientPool::Lease lease = pool->acquire(device);
+            benchmark::DoNotOptimize(lease.getClient().get());
+        }
+        state.counters["devices"] = (double) state.range(0);
+    }
+
+    static void createOpenClose(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        std::map<std::string, uint16_t> device = ClientFactory::createSimulatedShared(options)->listDevices().back();
+        for (auto _ : state) {
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+            client->open(device);
+            client->close();
+        }
+        state.counters["devices"] = (double) state.range(0);
+    }
+
+    BENCHMARK(acquire)->Name("ClientPool.acquire")->RangeMultiplier(4)->Range(1, 256);
+    BENCHMARK(createOpenClose)->Name("ClientPool.createOpenClose")->RangeMultiplier(4)->Range(1, 256);
+
+}
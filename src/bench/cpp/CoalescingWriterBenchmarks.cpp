@@ -0,0 +1,31 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/CoalescingWriter.hpp"
+
+namespace exqudens::usb {
+
+    static void write(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t> {}; };
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        client->open(client->listDevices().front());
+        CoalescingWriter writer(client, 0x01, 1000, (size_t) state.range(0), std::chrono::microseconds(100));
+        std::vector<uint8_t> value(16, 0x55);
+        for (auto _ : state) {
+            writer.write(value);
+        }
+        writer.flush();
+        state.SetBytesProcessed((int64_t) state.iterations() * (int64_t) value.size());
+        state.counters["transfers"] = (double) writer.getTransferCount();
+    }
+
+    BENCHMARK(write)->Name("CoalescingWriter.write")->ArgName("threshold")->RangeMultiplier(8)->Range(64, 32 << 10);
+
+}
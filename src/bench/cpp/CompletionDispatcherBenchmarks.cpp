@@ -0,0 +1,32 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <numeric>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/CompletionDispatcher.hpp"
+
+namespace exqudens::usb {
+
+    static void dispatch(benchmark::State& state) {
+        CompletionDispatcher dispatcher((size_t) state.range(0));
+        std::vector<std::vector<uint8_t>> transfers(128, std::vector<uint8_t>(4096, 0x55));
+        for (auto _ : state) {
+            for (size_t i = 0; i < transfers.size(); i++) {
+                // 'checksum' of a completed transfer, the key is the device
+                dispatcher.dispatch(i % 64, [&transfers, i]() {
+                    uint32_t result = std::accumulate(transfers.at(i).begin(), transfers.at(i).end(), 0u);
+                    benchmark::DoNotOptimize(result);
+                });
+            }
+            dispatcher.waitIdle();
+        }
+        state.SetItemsProcessed((int64_t) state.iterations() * (int64_t) transfers.size());
+        state.counters["maxQueueDepth"] = (double) dispatcher.getMetrics().maxQueueDepth;
+        state.counters["stolen"] = (double) dispatcher.getMetrics().stolen;
+    }
+
+    BENCHMARK(dispatch)->Name("CompletionDispatcher.dispatch")->ArgName("threads")->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+}
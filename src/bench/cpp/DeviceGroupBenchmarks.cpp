@@ -0,0 +1,49 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    static std::vector<std::shared_ptr<IClient>> createOpenClients(size_t size) {
+        std::vector<std::shared_ptr<IClient>> result = {};
+        SimulatedTransport::Options options = {};
+        options.latency = std::chrono::microseconds(100);
+        for (size_t i = 0; i < size; i++) {
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+            client->open(client->listDevices().front());
+            result.emplace_back(client);
+        }
+        return result;
+    }
+
+    static void transactAll(benchmark::State& state) {
+        std::shared_ptr<DeviceGroup> group = ClientFactory::createGroupShared(createOpenClients((size_t) state.range(0)));
+        std::vector<uint8_t> value(8, 0x55);
+        for (auto _ : state) {
+            std::vector<DeviceGroup::Result> results = group->transactAll(value, 1, 1000, 64);
+            benchmark::DoNotOptimize(results.data());
+        }
+    }
+
+    static void transactSequential(benchmark::State& state) {
+        std::vector<std::shared_ptr<IClient>> clients = createOpenClients((size_t) state.range(0));
+        std::vector<uint8_t> value(8, 0x55);
+        for (auto _ : state) {
+            for (const std::shared_ptr<IClient>& client : clients) {
+                client->bulkWrite(value, 1, 1000);
+                std::vector<uint8_t> result = client->bulkRead(1, 1000, 64);
+                benchmark::DoNotOptimize(result.data());
+            }
+        }
+    }
+
+    BENCHMARK(transactAll)->Name("DeviceGroup.transactAll")->ArgName("devices")->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond)->UseRealTime();
+    BENCHMARK(transactSequential)->Name("DeviceGroup.transactSequential")->ArgName("devices")->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+}
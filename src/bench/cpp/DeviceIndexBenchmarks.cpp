@@ -0,0 +1,41 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    // lookup of the last device by serial, a filtered enumeration against the index
+    static void findBySerialScan(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        DeviceFilter filter = {};
+        filter.serial = options.serialPrefix + std::to_string(options.deviceCount);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(client->listDevices(filter));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    static void findBySerialIndex(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.deviceCount = (size_t) state.range(0);
+        DeviceIndex index([&options]() { return ClientFactory::createSimulatedShared(options); });
+        index.refresh();
+        std::string serial = options.serialPrefix + std::to_string(options.deviceCount);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(index.findBySerial(serial));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(findBySerialScan)->Name("DeviceIndex.findBySerialScan")->ArgName("devices")->Arg(16)->Arg(256);
+    BENCHMARK(findBySerialIndex)->Name("DeviceIndex.findBySerialIndex")->ArgName("devices")->Arg(16)->Arg(256);
+
+}
@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <span>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/Framer.hpp"
+
+namespace exqudens::usb {
+
+    static void find(benchmark::State& state) {
+        std::vector<uint8_t> data((size_t) state.range(0), 'x');
+        data.back() = '\n';
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Framer::find(data.data(), data.size(), '\n'));
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0));
+    }
+
+    static void findScalar(benchmark::State& state) {
+        std::vector<uint8_t> data((size_t) state.range(0), 'x');
+        data.back() = '\n';
+        for (auto _ : state) {
+            size_t result = data.size();
+            for (size_t i = 0; i < data.size(); i++) {
+                if (data[i] == '\n') {
+                    result = i;
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * state.range(0));
+    }
+
+    static void next(benchmark::State& state) {
+        // 16 KiB reads of newline terminated messages
+        size_t messageSize = (size_t) state.range(0);
+        std::vector<uint8_t> data(16 << 10, 'x');
+        for (size_t i = messageSize - 1; i < data.size(); i += messageSize) {
+            data[i] = '\n';
+        }
+        Framer framer(Framer::Options {});
+        size_t count = 0;
+        for (auto _ : state) {
+            framer.push(data.data(), data.size());
+            for (std::optional<std::span<const uint8_t>> message = framer.next(); message; message = framer.next()) {
+                benchmark::DoNotOptimize(message.value().data());
+                count++;
+            }
+        }
+        state.SetBytesProcessed((int64_t) state.iterations() * (int64_t) data.size());
+        state.SetItemsProcessed((int64_t) count);
+    }
+
+    BENCHMARK(find)->Name("Framer.find")->RangeMultiplier(8)->Range(64, 64 << 10);
+    BENCHMARK(findScalar)->Name("Framer.findScalar")->RangeMultiplier(8)->Range(64, 64 << 10);
+    BENCHMARK(next)->Name("Framer.next")->ArgName("messageSize")->RangeMultiplier(4)->Range(16, 1024);
+
+}
@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/PriorityWriter.hpp"
+
+namespace exqudens::usb {
+
+    // a command submitted behind 16 queued 64 KiB data blocks on a 1 GB/s simulated link
+    static void commandLatency(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.bandwidth = 1000000000;
+        options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t>(); };
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        client->open(client->listDevices().front());
+        PriorityWriter writer(client, 0x01);
+        PriorityWriter::Priority priority = state.range(0) == 0 ? PriorityWriter::Priority::HIGH : PriorityWriter::Priority::LOW;
+        std::vector<uint8_t> data(64 << 10, 0x55);
+        std::vector<uint8_t> command(64, 0xC0);
+        std::mutex mutex = {};
+        std::condition_variable condition = {};
+        for (auto _ : state) {
+            state.PauseTiming();
+            for (size_t i = 0; i < 16; i++) {
+                writer.submit(data, PriorityWriter::Priority::LOW);
+            }
+            bool done = false;
+            state.ResumeTiming();
+            writer.submit(command, priority, [&mutex, &condition, &done](std::exception_ptr error) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done = true;
+                }
+                condition.notify_all();
+            });
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&done]() { return done; });
+            }
+            state.PauseTiming();
+            writer.flush();
+            state.ResumeTiming();
+        }
+        state.counters["maxWaitUs"] = (double) writer.getMetrics().at(priority).maxWait.count();
+    }
+
+    BENCHMARK(commandLatency)->Name("PriorityWriter.commandLatency")->ArgName("low")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+}
@@ -0,0 +1,43 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/Recorder.hpp"
+
+namespace exqudens::usb {
+
+    static void record(benchmark::State& state) {
+        std::vector<uint8_t> data(64 << 10, 0x55);
+        SimulatedTransport::Options transportOptions = {};
+        transportOptions.source = [&data](uint8_t endpoint, int32_t length) { return data; };
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(transportOptions);
+        client->open(client->listDevices().front());
+        Recorder::Options options = {};
+        options.directory = (std::filesystem::temp_directory_path() / "exqudens-usb-recorder").generic_string();
+        options.bufferSize = (size_t) state.range(0);
+        options.fileSize = 64 << 20;
+        uint64_t bytes = 0;
+        uint64_t overruns = 0;
+        for (auto _ : state) {
+            Recorder recorder(client, 0x81, options);
+            recorder.start();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            recorder.stop();
+            bytes += recorder.getStats().bytesWritten;
+            overruns += recorder.getStats().overrunCount;
+        }
+        std::filesystem::remove_all(options.directory);
+        state.SetBytesProcessed((int64_t) bytes);
+        state.counters["overruns"] = (double) overruns;
+    }
+
+    BENCHMARK(record)->Name("Recorder.record")->ArgName("bufferSize")->RangeMultiplier(4)->Range(4 << 10, 64 << 10)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
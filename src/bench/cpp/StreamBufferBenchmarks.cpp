@@ -0,0 +1,42 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/StreamBuffer.hpp"
+
+namespace exqudens::usb {
+
+    static void readByte(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.source = [](uint8_t endpoint, int32_t length) { return std::vector<uint8_t>((size_t) length, 0x55); };
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        client->open(client->listDevices().front());
+        StreamBuffer buffer(client, 0x81, 0x01, 1000, (size_t) state.range(0), StreamBuffer::PACKET_SIZE);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(buffer.sbumpc());
+        }
+        state.SetBytesProcessed((int64_t) state.iterations());
+        state.counters["transfers"] = (double) buffer.getReadCount();
+    }
+
+    static void writeByte(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t> {}; };
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        client->open(client->listDevices().front());
+        StreamBuffer buffer(client, 0x81, 0x01, 1000, (size_t) state.range(0), StreamBuffer::PACKET_SIZE);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(buffer.sputc(0x55));
+        }
+        state.SetBytesProcessed((int64_t) state.iterations());
+        state.counters["transfers"] = (double) buffer.getWriteCount();
+    }
+
+    BENCHMARK(readByte)->Name("StreamBuffer.readByte")->ArgName("capacity")->RangeMultiplier(8)->Range(512, 32 << 10);
+    BENCHMARK(writeByte)->Name("StreamBuffer.writeByte")->ArgName("capacity")->RangeMultiplier(8)->Range(512, 32 << 10);
+
+}
@@ -0,0 +1,28 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    // cost of the recording on top of a simulated 64 byte write, 'capacity' '0' disables it
+    static void bulkWrite(benchmark::State& state) {
+        SimulatedTransport::Options options = {};
+        options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t>(); };
+        std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+        client->open(client->listDevices().front());
+        client->setTimelineCapacity((size_t) state.range(0));
+        std::vector<uint8_t> value(64, 0x55);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(client->bulkWrite(value, 0x01, 1000, false));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(bulkWrite)->Name("TransferTimeline.bulkWrite")->ArgName("capacity")->Arg(0)->Arg(1024);
+
+}
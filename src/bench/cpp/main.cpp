@@ -0,0 +1,17 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "exqudens/usb/versions.hpp"
+
+int main(int argc, char** argv) {
+    std::string version = std::to_string(PROJECT_VERSION_MAJOR) + "." + std::to_string(PROJECT_VERSION_MINOR) + "." + std::to_string(PROJECT_VERSION_PATCH);
+    benchmark::AddCustomContext("project.version", version);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
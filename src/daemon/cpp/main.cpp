@@ -0,0 +1,122 @@
+#include <cstddef>
+#include <cstdint>
+#include <csignal>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <iostream>
+
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/SharedMemoryServer.hpp"
+#include "exqudens/usb/versions.hpp"
+
+#include "CommandLine.hpp"
+
+using exqudens::usb::ClientFactory;
+using exqudens::usb::CommandLine;
+using exqudens::usb::DeviceFilter;
+using exqudens::usb::IClient;
+using exqudens::usb::SharedMemoryServer;
+
+static const char* USAGE = R"(Usage: daemon-app [options]
+
+Claims the first device matching the filter and serves it to local processes through shared memory
+until interrupted. Clients use 'ClientFactory::createSharedMemoryShared(name)'.
+
+Device:
+  --simulated                 Serve an in-process simulated echo device instead of libusb.
+  --vendor=<id>               Vendor id, e.g. '0x0484'.
+  --product=<id>              Product id.
+  --bus=<number>              Bus number.
+  --serial=<string>           Serial number.
+  --interface=<number>        Interface to claim, default '0'.
+
+Server:
+  --name=<string>             Shared memory name, default '/exqudens-usb'.
+  --in-endpoints=<a,b,...>    IN endpoint addresses to publish, default '0x81'.
+  --in-capacity=<bytes>       Per IN ring, default '4194304'.
+  --out-capacity=<bytes>      OUT queue, default '1048576'.
+  --read-size=<bytes>         Bytes per bulk read, default '16384'.
+  --write-timeout=<ms>        Per OUT message, default '1000'.
+  --help
+)";
+
+static std::atomic<bool> interrupted = false;
+
+int main(int argc, char** argv) {
+    try {
+        std::map<std::string, std::string> args = CommandLine::toArgs(argc, argv);
+        if (args.contains("help")) {
+            std::cout << USAGE;
+            return 0;
+        }
+
+        SharedMemoryServer::Options options = {};
+        options.inEndpoints.clear();
+        for (size_t endpoint : CommandLine::toNumbers(args, "in-endpoints", "0x81")) {
+            options.inEndpoints.insert((uint8_t) endpoint);
+        }
+        options.inCapacity = CommandLine::toNumber(args, "in-capacity", options.inCapacity);
+        options.outCapacity = CommandLine::toNumber(args, "out-capacity", options.outCapacity);
+        options.readSize = CommandLine::toNumber(args, "read-size", options.readSize);
+        options.writeTimeout = (uint32_t) CommandLine::toNumber(args, "write-timeout", options.writeTimeout);
+        std::string name = args.contains("name") ? args.at("name") : "/exqudens-usb";
+
+        DeviceFilter filter = {};
+        if (args.contains("vendor")) {
+            filter.vendors.insert((uint16_t) CommandLine::toNumber(args, "vendor", 0));
+        }
+        if (args.contains("product")) {
+            filter.products.insert((uint16_t) CommandLine::toNumber(args, "product", 0));
+        }
+        if (args.contains("bus")) {
+            filter.bus = (uint16_t) CommandLine::toNumber(args, "bus", 0);
+        }
+        if (args.contains("serial")) {
+            filter.serial = args.at("serial");
+        }
+
+        std::shared_ptr<IClient> client = args.contains("simulated") ? ClientFactory::createSimulatedShared({}) : ClientFactory::createShared(true, true);
+        std::vector<std::map<std::string, uint16_t>> devices = client->listDevices(filter);
+        if (devices.empty()) {
+            throw std::runtime_error("no device matches the filter");
+        }
+        client->open(devices.front(), (int32_t) CommandLine::toNumber(args, "interface", 0), {});
+
+        SharedMemoryServer server(client, name, options);
+        std::signal(SIGINT, [](int) { interrupted = true; });
+        std::signal(SIGTERM, [](int) { interrupted = true; });
+        server.start();
+
+        std::cout << "version: " << PROJECT_VERSION_MAJOR << "." << PROJECT_VERSION_MINOR << "." << PROJECT_VERSION_PATCH << std::endl;
+        std::cout << "device: " << client->toString(devices.front()) << std::endl;
+        std::cout << "serving: '" << name << "'" << std::endl;
+
+        // a failed reader thread stops serving its endpoint, 'stop' rethrows its error and the daemon exits with '1'
+        while (!interrupted && !server.getError()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        server.stop();
+        client->close();
+
+        SharedMemoryServer::Stats stats = server.getStats();
+        std::cout << "bytesRead: " << stats.bytesRead << std::endl;
+        std::cout << "readCount: " << stats.readCount << std::endl;
+        std::cout << "bytesWritten: " << stats.bytesWritten << std::endl;
+        std::cout << "writeCount: " << stats.writeCount << std::endl;
+        std::cout << "writeErrors: " << stats.writeErrors << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        for (const std::string& element : CommandLine::toStackTrace(e)) {
+            std::cerr << element << std::endl;
+        }
+        return 1;
+    }
+}
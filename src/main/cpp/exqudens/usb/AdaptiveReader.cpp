@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include <libusb.h>
+
+#include "exqudens/usb/AdaptiveReader.hpp"
+#include "exqudens/usb/TransferError.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    AdaptiveReader::AdaptiveReader(
+        const std::shared_ptr<IClient>& client,
+        uint8_t endpoint,
+        const Options& options
+    ):
+        client(client),
+        endpoint(endpoint),
+        options(options)
+    {
+        try {
+            if (!this->client) {
+                throw std::runtime_error(CALL_INFO + ": client is null!");
+            }
+            if (options.packetSize == 0) {
+                throw std::runtime_error(CALL_INFO + ": packetSize must be greater zero!");
+            }
+            if (options.minPackets == 0 || options.minPackets > options.maxPackets) {
+                throw std::runtime_error(CALL_INFO + ": minPackets must be in [1, maxPackets]!");
+            }
+            if (options.minTimeout == 0 || options.minTimeout > options.maxTimeout) {
+                throw std::runtime_error(CALL_INFO + ": minTimeout must be in [1, maxTimeout]!");
+            }
+            if (options.smoothing <= 0 || options.smoothing > 1) {
+                throw std::runtime_error(CALL_INFO + ": smoothing must be in (0, 1]!");
+            }
+            data.resize(options.packetSize * options.maxPackets);
+            packets = options.minPackets;
+            // nothing is known yet, an idle endpoint should not cost polls
+            stats.readSize = packets * options.packetSize;
+            stats.timeout = options.maxTimeout;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    AdaptiveReader::AdaptiveReader(const std::shared_ptr<IClient>& client, uint8_t endpoint): AdaptiveReader(client, endpoint, Options()) {}
+
+    std::span<const uint8_t> AdaptiveReader::read() {
+        try {
+            size_t size = 0;
+            bool timedOut = false;
+            try {
+                Buffer buffer(data.data(), stats.readSize, false, {});
+                size = client->bulkRead(buffer, endpoint, stats.timeout, false);
+            } catch (const std::exception& e) {
+                std::optional<TransferError> error = TransferError::find(e);
+                if (!error || error.value().getLibusbError() != LIBUSB_ERROR_TIMEOUT) {
+                    throw;
+                }
+                // the bytes received before the wait window passed are in the buffer
+                size = std::min(error.value().getTransferred(), stats.readSize);
+                timedOut = true;
+            }
+            update(size, timedOut);
+            return {data.data(), size};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    AdaptiveReader::Stats AdaptiveReader::getStats() {
+        try {
+            return stats;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void AdaptiveReader::update(size_t size, bool timedOut) {
+        try {
+            stats.reads++;
+            if (size == 0) {
+                stats.emptyReads++;
+                stats.timeout = (uint32_t) std::min<uint64_t>((uint64_t) stats.timeout * 2, options.maxTimeout);
+                return;
+            }
+
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            double alpha = options.smoothing;
+            stats.bytes += size;
+            stats.averageSize = stats.bytes == size ? (double) size : alpha * (double) size + (1 - alpha) * stats.averageSize;
+            if (arrival) {
+                double interval = std::chrono::duration<double, std::milli>(now - arrival.value()).count();
+                stats.averageInterval = stats.averageInterval == 0 ? interval : alpha * interval + (1 - alpha) * stats.averageInterval;
+                double timeout = std::ceil(stats.averageInterval * 2);
+                stats.timeout = (uint32_t) std::clamp(timeout, (double) options.minTimeout, (double) options.maxTimeout);
+            }
+            arrival = now;
+
+            if (timedOut) {
+                stats.partialReads++;
+                burstPackets = std::max(burstPackets, (size + options.packetSize - 1) / options.packetSize);
+                packets = std::clamp(burstPackets, options.minPackets, options.maxPackets);
+            } else if (size == stats.readSize) {
+                stats.fullReads++;
+                packets = std::min(packets * 2, burstPackets == 0 ? options.maxPackets : std::max(burstPackets, packets));
+            } else if (stats.averageSize * 4 <= (double) stats.readSize) {
+                packets = std::max(packets / 2, options.minPackets);
+            }
+            stats.readSize = packets * options.packetSize;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
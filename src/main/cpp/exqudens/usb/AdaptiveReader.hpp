@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <span>
+#include <chrono>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Bulk IN reader that picks its read size and wait window from the observed traffic.
+    * A read filling the whole read size doubles it (a burst was split), reads averaging under a quarter of it halve it.
+    * A read timing out with data (a burst ending on a packet boundary sends no short packet) keeps the data
+    * and caps the read size at the largest such burst, so it does not grow past it again.
+    * A timed out read doubles the wait window (idle endpoint), a read with data sets it to twice the average inter-arrival time.
+    * Returned data is a view into the receive buffer, valid until the next 'read'.
+    */
+    class EXQUDENS_USB_EXPORT AdaptiveReader {
+
+        public:
+
+            struct Options {
+                size_t packetSize = 512; //!< 'wMaxPacketSize' of the endpoint, read sizes are multiples of it.
+                size_t minPackets = 1;
+                size_t maxPackets = 128;
+                uint32_t minTimeout = 1; //!< Milliseconds.
+                uint32_t maxTimeout = 1000; //!< Milliseconds.
+                double smoothing = 0.25; //!< Weight of the newest sample in the moving averages.
+            };
+
+            struct Stats {
+                size_t readSize = 0; //!< Current read size in bytes.
+                uint32_t timeout = 0; //!< Current wait window in milliseconds.
+                double averageSize = 0; //!< Bytes per non-empty read.
+                double averageInterval = 0; //!< Milliseconds between non-empty reads.
+                uint64_t reads = 0;
+                uint64_t emptyReads = 0; //!< Timed out reads.
+                uint64_t fullReads = 0; //!< Reads that filled the read size.
+                uint64_t partialReads = 0; //!< Reads ended by the wait window with data.
+                uint64_t bytes = 0;
+            };
+
+        private:
+
+            std::shared_ptr<IClient> client = nullptr;
+            uint8_t endpoint = 0;
+            Options options = {};
+            std::vector<uint8_t> data = {};
+            size_t packets = 0;
+            size_t burstPackets = 0;
+            Stats stats = {};
+            std::optional<std::chrono::steady_clock::time_point> arrival = {};
+
+        public:
+
+            AdaptiveReader(
+                const std::shared_ptr<IClient>& client,
+                uint8_t endpoint, //!< IN endpoint address, e.g. '0x81'.
+                const Options& options
+            );
+            AdaptiveReader(const std::shared_ptr<IClient>& client, uint8_t endpoint);
+            AdaptiveReader(const AdaptiveReader& other) = delete;
+
+            AdaptiveReader& operator=(const AdaptiveReader& other) = delete;
+
+            /*!
+            * Performs one bulk read with the current read size and wait window.
+            *
+            * @return The read data, empty if the wait window passed without data.
+            *
+            * @throws std::runtime_error
+            */
+            std::span<const uint8_t> read();
+
+            Stats getStats();
+
+        private:
+
+            void update(size_t size, bool timedOut);
+
+    };
+
+}
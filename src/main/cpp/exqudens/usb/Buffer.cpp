@@ -0,0 +1,115 @@
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/Buffer.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    Buffer::Buffer(
+        uint8_t* data,
+        size_t capacity,
+        bool deviceMemory,
+        const std::function<void(uint8_t* data, size_t capacity, bool deviceMemory)>& releaseFunction
+    ):
+        data(data),
+        capacity(capacity),
+        deviceMemory(deviceMemory),
+        releaseFunction(releaseFunction)
+    {
+    }
+
+    Buffer::Buffer() = default;
+
+    Buffer::Buffer(Buffer&& other) noexcept:
+        data(std::exchange(other.data, nullptr)),
+        capacity(std::exchange(other.capacity, 0)),
+        size(std::exchange(other.size, 0)),
+        deviceMemory(std::exchange(other.deviceMemory, false)),
+        releaseFunction(std::exchange(other.releaseFunction, {}))
+    {
+    }
+
+    Buffer& Buffer::operator=(Buffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            data = std::exchange(other.data, nullptr);
+            capacity = std::exchange(other.capacity, 0);
+            size = std::exchange(other.size, 0);
+            deviceMemory = std::exchange(other.deviceMemory, false);
+            releaseFunction = std::exchange(other.releaseFunction, {});
+        }
+        return *this;
+    }
+
+    uint8_t* Buffer::getData() {
+        try {
+            return data;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    const uint8_t* Buffer::getData() const {
+        try {
+            return data;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Buffer::getCapacity() const {
+        try {
+            return capacity;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Buffer::getSize() const {
+        try {
+            return size;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void Buffer::setSize(size_t value) {
+        try {
+            if (value > capacity) {
+                throw std::runtime_error(CALL_INFO + ": value: " + std::to_string(value) + " greater than capacity: " + std::to_string(capacity));
+            }
+            size = value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool Buffer::isDeviceMemory() const {
+        try {
+            return deviceMemory;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void Buffer::release() noexcept {
+        if (data != nullptr && releaseFunction) {
+            releaseFunction(data, capacity, deviceMemory);
+        }
+        data = nullptr;
+        capacity = 0;
+        size = 0;
+        deviceMemory = false;
+        releaseFunction = {};
+    }
+
+    Buffer::~Buffer() noexcept {
+        release();
+    }
+
+}
+
+#undef CALL_INFO
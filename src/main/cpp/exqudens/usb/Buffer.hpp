@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "exqudens/usb/export.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Move-only transfer buffer leased from a transport.
+    * The memory is returned to the owning pool on destruction.
+    */
+    class EXQUDENS_USB_EXPORT Buffer {
+
+        private:
+
+            uint8_t* data = nullptr;
+            size_t capacity = 0;
+            size_t size = 0;
+            bool deviceMemory = false;
+            std::function<void(uint8_t* data, size_t capacity, bool deviceMemory)> releaseFunction = {};
+
+        public:
+
+            Buffer(
+                uint8_t* data,
+                size_t capacity,
+                bool deviceMemory,
+                const std::function<void(uint8_t* data, size_t capacity, bool deviceMemory)>& releaseFunction
+            );
+            Buffer();
+            Buffer(const Buffer& other) = delete;
+            Buffer(Buffer&& other) noexcept;
+
+            Buffer& operator=(const Buffer& other) = delete;
+            Buffer& operator=(Buffer&& other) noexcept;
+
+            uint8_t* getData();
+            const uint8_t* getData() const;
+
+            size_t getCapacity() const;
+
+            size_t getSize() const;
+
+            void setSize(size_t value);
+
+            /*!
+            * @return 'true' if the memory is mapped by the kernel driver ('libusb_dev_mem_alloc') and transfers skip the bounce copy.
+            */
+            bool isDeviceMemory() const;
+
+            void release() noexcept;
+
+            ~Buffer() noexcept;
+
+    };
+
+}
@@ -0,0 +1,51 @@
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/CancellationToken.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    void CancellationToken::cancel() {
+        try {
+            // callbacks run under the lock so 'unsubscribe' can wait for a running one
+            std::lock_guard<std::mutex> lock(mutex);
+            if (cancelled.exchange(true)) {
+                return;
+            }
+            for (const auto& [id, callback] : callbacks) {
+                callback();
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool CancellationToken::isCancelled() const noexcept {
+        return cancelled.load();
+    }
+
+    size_t CancellationToken::subscribe(const std::function<void()>& callback) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t id = nextId++;
+            if (cancelled.load()) {
+                callback();
+            } else {
+                callbacks.insert({id, callback});
+            }
+            return id;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CancellationToken::unsubscribe(size_t id) noexcept {
+        std::lock_guard<std::mutex> lock(mutex);
+        callbacks.erase(id);
+    }
+
+}
+
+#undef CALL_INFO
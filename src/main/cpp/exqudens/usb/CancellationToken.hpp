@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <functional>
+#include <mutex>
+#include <atomic>
+
+#include "exqudens/usb/export.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Cooperative cancellation shared between the caller and in-flight transfers.
+    * 'cancel' runs the registered callbacks (e.g. 'libusb_cancel_transfer') and is sticky.
+    */
+    class EXQUDENS_USB_EXPORT CancellationToken {
+
+        private:
+
+            std::atomic<bool> cancelled = false;
+            std::mutex mutex = {};
+            size_t nextId = 1;
+            std::map<size_t, std::function<void()>> callbacks = {};
+
+        public:
+
+            void cancel();
+
+            bool isCancelled() const noexcept;
+
+            /*!
+            * Registers a callback run on 'cancel', it is run immediately if already cancelled.
+            * Callbacks must not subscribe or unsubscribe.
+            *
+            * @return An id for 'unsubscribe'.
+            */
+            size_t subscribe(const std::function<void()>& callback);
+
+            /*!
+            * Removes the callback, once returned the callback is not running and will not run.
+            */
+            void unsubscribe(size_t id) noexcept;
+
+    };
+
+}
@@ -1,8 +1,19 @@
+#include <cstdint>
 #include <climits>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <utility>
 #include <filesystem>
 #include <stdexcept>
 
+#include <libusb.h>
+
 #include "exqudens/usb/Client.hpp"
+#include "exqudens/usb/LibusbTransport.hpp"
+#include "exqudens/usb/DescriptorCache.hpp"
+#include "exqudens/usb/Probes.hpp"
+#include "exqudens/usb/TransferError.hpp"
 #include "exqudens/usb/versions.hpp"
 
 #define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
@@ -11,6 +22,17 @@
 
 namespace exqudens::usb {
 
+    namespace {
+
+        std::atomic<uint64_t> nextId = 1;
+
+        // per thread, so concurrent transfers on one client each see their own, keyed by the client id
+        thread_local std::pair<uint64_t, TransferInfo> lastTransfer = {0, {}};
+
+        constexpr std::chrono::milliseconds RECONNECT_POLL_INTERVAL = std::chrono::milliseconds(10); //!< Longest reconnect wait before the token is checked again.
+
+    }
+
     Client::Client(
         bool autoInit,
         bool autoClose,
@@ -21,21 +43,48 @@ namespace exqudens::usb {
             const std::string& id,
             uint16_t level,
             const std::string& message
-        )>& logFunction
+        )>& logFunction,
+        const std::shared_ptr<ITransport>& transport
     ):
+        logFunction(logFunction),
         autoInit(autoInit),
         autoClose(autoClose),
-        logFunction(logFunction)
+        id(nextId++),
+        transport(transport)
     {
+        if (!this->transport) {
+            throw std::runtime_error(CALL_INFO + ": transport is null!");
+        }
         if (autoInit) {
             init();
         }
     }
 
+    Client::Client(
+        bool autoInit,
+        bool autoClose,
+        const std::function<void(
+            const std::string& file,
+            size_t line,
+            const std::string& function,
+            const std::string& id,
+            uint16_t level,
+            const std::string& message
+        )>& logFunction
+    ): Client(autoInit, autoClose, logFunction, std::make_shared<LibusbTransport>()) {}
+
     Client::Client(bool autoInit, bool autoClose): Client(autoInit, autoClose, {}) {}
 
     Client::Client(): Client(true, true, {}) {}
 
+    std::shared_ptr<ITransport> Client::getTransport() {
+        try {
+            return transport;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     std::string Client::getLoggerId() {
         try {
             return std::string(LOGGER_ID);
@@ -71,13 +120,8 @@ namespace exqudens::usb {
 
     void Client::init() {
         try {
-            if (context == nullptr) {
-                int libusbError = libusb_init(&context);
-                if (libusbError) {
-                    const char* libusbErrorName = libusb_error_name(libusbError);
-                    throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
-                }
-            }
+            transport->init();
+            EXQUDENS_USB_PROBE0(init);
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -85,11 +129,7 @@ namespace exqudens::usb {
 
     bool Client::isInitialized() {
         try {
-            if (context == nullptr) {
-                return false;
-            } else {
-                return true;
-            }
+            return transport->isInitialized();
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -111,21 +151,113 @@ namespace exqudens::usb {
 
     std::vector<std::map<std::string, uint16_t>> Client::listDevices() {
         try {
-            std::vector<std::map<std::string, uint16_t>> result = {};
-            libusb_device** libusbDevices;
-            ssize_t libusbDevicesSize = libusb_get_device_list(context, &libusbDevices);
-            for (ssize_t i = 0; i < libusbDevicesSize; i++) {
-                libusb_device* libusbDevice = libusbDevices[i];
-                std::map<std::string, uint16_t> entry = toMap(libusbDevice);
-                result.emplace_back(entry);
+            std::chrono::steady_clock::time_point start = EXQUDENS_USB_PROBE_ENABLED(list_devices) ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+            std::vector<std::map<std::string, uint16_t>> result = transport->listDevices();
+            // detached devices are not listed, drop their strings
+            {
+                std::lock_guard<std::mutex> lock(stringsMutex);
+                std::erase_if(strings, [&result](const auto& entry) { return std::ranges::find(result, entry.first) == result.end(); });
+            }
+            if (EXQUDENS_USB_PROBE_ENABLED(list_devices)) {
+                int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                EXQUDENS_USB_PROBE2(list_devices, (int) result.size(), duration);
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> Client::listDevices(const DeviceFilter& filter) {
+        try {
+            std::chrono::steady_clock::time_point start = EXQUDENS_USB_PROBE_ENABLED(list_devices) ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+            // the serial is matched against the cached strings, so only new devices cost control transfers
+            DeviceFilter transportFilter = filter;
+            transportFilter.serial = {};
+            std::vector<std::map<std::string, uint16_t>> result = transport->listDevices(transportFilter);
+            if (filter.serial) {
+                std::erase_if(result, [this, &filter](const std::map<std::string, uint16_t>& entry) {
+                    try {
+                        return getStringDescriptor(entry, StringDescriptor::SERIAL_NUMBER) != filter.serial;
+                    } catch (...) {
+                        // detached after the enumeration
+                        return true;
+                    }
+                });
+            }
+            if (EXQUDENS_USB_PROBE_ENABLED(list_devices)) {
+                int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                EXQUDENS_USB_PROBE2(list_devices, (int) result.size(), duration);
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::string> Client::getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) {
+        try {
+            {
+                std::lock_guard<std::mutex> lock(stringsMutex);
+                auto entry = strings.find(device);
+                if (entry != strings.end() && entry->second.contains(type)) {
+                    return entry->second.at(type);
+                }
+            }
+            // read outside the lock, a concurrent read of the same string is only wasted work
+            try {
+                std::optional<std::string> result = transport->getStringDescriptor(device, type);
+                std::lock_guard<std::mutex> lock(stringsMutex);
+                strings[device].insert({type, result});
+                return result;
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(stringsMutex);
+                strings.erase(device);
+                throw;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Client::loadDescriptorCache(const std::string& path) {
+        try {
+            size_t result = 0;
+            std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> cache = DescriptorCache::read(path);
+            if (cache.empty()) {
+                return result;
+            }
+            for (const std::map<std::string, uint16_t>& entry : transport->listDevices()) {
+                // matched by identity, files written before the port path keys have none
+                auto cached = std::ranges::find_if(cache, [&entry](const auto& element) { return ITransport::matches(element.first, entry); });
+                if (cached == cache.end()) {
+                    continue;
+                }
+                // strings read in this session win over the file
+                std::lock_guard<std::mutex> lock(stringsMutex);
+                strings[entry].merge(cached->second);
+                result++;
             }
-            libusb_free_device_list(libusbDevices, 1);
+            log(__FILE__, __LINE__, __FUNCTION__, LOGGER_ID, LOGGER_LEVEL_DEBUG, "loaded descriptors: " + std::to_string(result) + " of: " + std::to_string(cache.size()));
             return result;
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
     }
 
+    void Client::saveDescriptorCache(const std::string& path) {
+        try {
+            std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> cache = {};
+            {
+                std::lock_guard<std::mutex> lock(stringsMutex);
+                cache = strings;
+            }
+            DescriptorCache::write(path, cache);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     std::string Client::toString(const std::map<std::string, uint16_t>& value) {
         try {
             std::string result = "";
@@ -176,60 +308,20 @@ namespace exqudens::usb {
 
             log(__FILE__, __LINE__, __FUNCTION__, LOGGER_ID, LOGGER_LEVEL_DEBUG, "selected device: " + toString(deviceForOpen));
 
-            libusb_device** libusbDevices;
-            ssize_t libusbDevicesSize = libusb_get_device_list(context, &libusbDevices);
-            for (ssize_t i = 0; i < libusbDevicesSize; i++) {
-                libusb_device* libusbDevice = libusbDevices[i];
-                std::map<std::string, uint16_t> entry = toMap(libusbDevice);
-                if (entry == deviceForOpen) {
-                    int libusbError = libusb_open(libusbDevice, &handle);
-                    if (libusbError != 0) {
-                        libusb_free_device_list(libusbDevices, 1);
-                        const char* libusbErrorName = libusb_error_name(libusbError);
-                        throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
-                    }
-                    break;
-                }
+            transport->open(deviceForOpen, interfaceNumber.value_or(0), detachKernelDriver);
+            if (EXQUDENS_USB_PROBE_ENABLED(open)) {
+                std::map<std::string, uint16_t> probe = deviceForOpen;
+                EXQUDENS_USB_PROBE4(open, (int) probe["vendor"], (int) probe["product"], (int) probe["bus"], (int) probe["address"]);
             }
-            libusb_free_device_list(libusbDevices, 1);
 
-            if (!isOpen()) {
-                throw std::runtime_error(CALL_INFO + ": device handle is null!");
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                device = deviceForOpen;
+                this->interfaceNumber = interfaceNumber;
+                this->detachKernelDriver = detachKernelDriver;
             }
-
-            this->interfaceNumber = interfaceNumber.value_or(0);
-            int libusbError = 0;
-
-            if (detachKernelDriver) {
-                if (detachKernelDriver.value()) {
-                    attachKernelDriver = true;
-                    libusbError = libusb_detach_kernel_driver(handle, this->interfaceNumber.value());
-                    if (libusbError != 0) {
-                        libusb_close(handle);
-                        const char* libusbErrorName = libusb_error_name(libusbError);
-                        throw std::runtime_error(CALL_INFO + ": unable to detach kernel driver interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
-                    }
-                }
-            } else {
-                if (libusb_kernel_driver_active(handle, this->interfaceNumber.value()) == 1) {
-                    attachKernelDriver = true;
-                    libusbError = libusb_detach_kernel_driver(handle, this->interfaceNumber.value());
-                    if (libusbError != 0) {
-                        libusb_close(handle);
-                        const char* libusbErrorName = libusb_error_name(libusbError);
-                        throw std::runtime_error(CALL_INFO + ": unable to detach kernel driver interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
-                    }
-                }
-            }
-
-            libusbError = libusb_claim_interface(handle, this->interfaceNumber.value());
-            if (libusbError != 0) {
-                libusb_close(handle);
-                const char* libusbErrorName = libusb_error_name(libusbError);
-                throw std::runtime_error(CALL_INFO + ": unable to claim interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
-            }
-
-            device = deviceForOpen;
+            connection++;
+            reconnecting = false;
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -245,11 +337,7 @@ namespace exqudens::usb {
 
     bool Client::isOpen() {
         try {
-            if (handle == nullptr) {
-                return false;
-            } else {
-                return true;
-            }
+            return transport->isOpen();
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -257,12 +345,97 @@ namespace exqudens::usb {
 
     std::map<std::string, uint16_t> Client::getDevice() {
         try {
+            std::lock_guard<std::mutex> lock(mutex);
             return device;
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
     }
 
+    void Client::setReconnect(const std::optional<uint32_t>& timeout) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            reconnectTimeout = timeout;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool Client::isReconnecting() {
+        try {
+            return reconnecting;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool Client::reconnect(uint32_t timeout) {
+        try {
+            return reconnect(std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout), {}, nullptr);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void Client::setTimelineCapacity(size_t capacity) {
+        try {
+            timeline.setCapacity(capacity);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<TransferInfo> Client::getTimeline() {
+        try {
+            return timeline.get();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<TransferInfo> Client::getLastTransfer() {
+        try {
+            if (!timeline.isEnabled() || lastTransfer.first != id) {
+                return {};
+            }
+            return lastTransfer.second;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::string> Client::tuneCurrentThread() {
+        try {
+            std::shared_ptr<LibusbTransport> libusbTransport = std::dynamic_pointer_cast<LibusbTransport>(transport);
+            if (!libusbTransport) {
+                return {};
+            }
+            return libusbTransport->tuneCurrentThread();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::string> Client::getThreadErrors() {
+        try {
+            std::shared_ptr<LibusbTransport> libusbTransport = std::dynamic_pointer_cast<LibusbTransport>(transport);
+            if (!libusbTransport) {
+                return {};
+            }
+            return libusbTransport->getThreadErrors();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Buffer Client::allocateBuffer(size_t capacity) {
+        try {
+            return transport->allocateBuffer(capacity);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     uint8_t Client::toWriteEndpoint(uint8_t endpoint) {
         try {
             return endpoint | LIBUSB_ENDPOINT_OUT;
@@ -281,28 +454,8 @@ namespace exqudens::usb {
 
     size_t Client::bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) {
         try {
-            if (value.size() > INT_MAX) {
-                throw std::runtime_error(CALL_INFO + ": value.size: " + std::to_string(value.size()) + " greater than INT_MAX: " + std::to_string(INT_MAX));
-            }
-            int libusbBulkTransfered = 0;
             std::vector<uint8_t>& data = const_cast<std::vector<uint8_t>&>(value);
-            int libusbError = libusb_bulk_transfer(
-                handle,
-                (autoEndpointDirection ? toWriteEndpoint(endpoint) : endpoint),
-                data.data(),
-                (int) data.size(),
-                &libusbBulkTransfered,
-                timeout
-            );
-            if (libusbError) {
-                const char* libusbErrorName = libusb_error_name(libusbError);
-                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
-            }
-            if (libusbBulkTransfered < 0) {
-                throw std::runtime_error(CALL_INFO + ": libusbBulkTransfered: " + std::to_string(libusbBulkTransfered) + " less zero");
-            }
-            size_t result = (size_t) libusbBulkTransfered;
-            return result;
+            return write(data.data(), data.size(), (autoEndpointDirection ? toWriteEndpoint(endpoint) : endpoint), timeout, {}, nullptr);
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -324,6 +477,39 @@ namespace exqudens::usb {
         }
     }
 
+    size_t Client::bulkWrite(const Buffer& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) {
+        try {
+            return write(const_cast<uint8_t*>(value.getData()), value.getSize(), (autoEndpointDirection ? toWriteEndpoint(endpoint) : endpoint), timeout, {}, nullptr);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Client::bulkWrite(const Buffer& value, uint8_t endpoint, uint32_t timeout) {
+        try {
+            return bulkWrite(value, endpoint, timeout, true);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Client::bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            std::vector<uint8_t>& data = const_cast<std::vector<uint8_t>&>(value);
+            return write(data.data(), data.size(), toWriteEndpoint(endpoint), toTimeout(deadline), deadline, token);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Client::bulkWrite(const Buffer& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            return write(const_cast<uint8_t*>(value.getData()), value.getSize(), toWriteEndpoint(endpoint), toTimeout(deadline), deadline, token);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     std::vector<uint8_t> Client::bulkRead(uint8_t endpoint, uint32_t timeout, int32_t size, bool autoEndpointDirection) {
         try {
             if (size < 0) {
@@ -331,23 +517,7 @@ namespace exqudens::usb {
             }
             std::vector<uint8_t> result = {};
             result.resize(size);
-            int libusbBulkTransfered = 0;
-            int libusbError = libusb_bulk_transfer(
-                handle,
-                (autoEndpointDirection ? toReadEndpoint(endpoint) : endpoint),
-                result.data(),
-                (int) result.size(),
-                &libusbBulkTransfered,
-                timeout
-            );
-            if (libusbError) {
-                const char* libusbErrorName = libusb_error_name(libusbError);
-                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
-            }
-            if (libusbBulkTransfered < 0) {
-                throw std::runtime_error(CALL_INFO + ": libusbBulkTransfered: " + std::to_string(libusbBulkTransfered) + " less zero");
-            }
-            result.resize(libusbBulkTransfered);
+            result.resize(read(result.data(), result.size(), (autoEndpointDirection ? toReadEndpoint(endpoint) : endpoint), timeout, {}, nullptr));
             return result;
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
@@ -378,29 +548,59 @@ namespace exqudens::usb {
         }
     }
 
+    size_t Client::bulkRead(Buffer& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) {
+        try {
+            value.setSize(0);
+            value.setSize(read(value.getData(), value.getCapacity(), (autoEndpointDirection ? toReadEndpoint(endpoint) : endpoint), timeout, {}, nullptr));
+            return value.getSize();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Client::bulkRead(Buffer& value, uint8_t endpoint, uint32_t timeout) {
+        try {
+            return bulkRead(value, endpoint, timeout, true);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<uint8_t> Client::bulkRead(uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, int32_t size, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            if (size < 0) {
+                throw std::runtime_error(CALL_INFO + ": size: " + std::to_string(size) + " less zero");
+            }
+            std::vector<uint8_t> result = {};
+            result.resize(size);
+            result.resize(read(result.data(), result.size(), toReadEndpoint(endpoint), toTimeout(deadline), deadline, token));
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Client::bulkRead(Buffer& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            value.setSize(0);
+            value.setSize(read(value.getData(), value.getCapacity(), toReadEndpoint(endpoint), toTimeout(deadline), deadline, token));
+            return value.getSize();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     void Client::close() {
         try {
-            if (handle != nullptr) {
-                int libusbError = libusb_release_interface(handle, interfaceNumber.value());
-                if (libusbError != 0) {
-                    libusb_close(handle);
-                    const char* libusbErrorName = libusb_error_name(libusbError);
-                    throw std::runtime_error(CALL_INFO + ": unable to release interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
-                }
-                if (attachKernelDriver) {
-                    libusbError = libusb_attach_kernel_driver(handle, interfaceNumber.value());
-                    if (libusbError != 0) {
-                        libusb_close(handle);
-                        const char* libusbErrorName = libusb_error_name(libusbError);
-                        throw std::runtime_error(CALL_INFO + ": unable to attach kernel driver: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
-                    }
-                }
-                libusb_close(handle);
-                handle = nullptr;
+            transport->close();
+            EXQUDENS_USB_PROBE0(close);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                device = {};
+                interfaceNumber = {};
+                detachKernelDriver = {};
             }
-            device = {};
-            attachKernelDriver = false;
-            interfaceNumber = {};
+            reconnecting = false;
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -408,10 +608,7 @@ namespace exqudens::usb {
 
     void Client::destroy() {
         try {
-            if (context != nullptr) {
-                libusb_exit(context);
-                context = nullptr;
-            }
+            transport->destroy();
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
@@ -438,30 +635,215 @@ namespace exqudens::usb {
         }
     }
 
-    std::map<std::string, uint16_t> Client::toMap(libusb_device* libusbDevice) {
+    size_t Client::write(uint8_t* data, size_t size, uint8_t endpoint, uint32_t timeout, const std::optional<std::chrono::steady_clock::time_point>& deadline, const std::shared_ptr<CancellationToken>& token) {
         try {
-            std::map<std::string, uint16_t> result = {};
+            if (size > INT_MAX) {
+                throw std::runtime_error(CALL_INFO + ": value.size: " + std::to_string(size) + " greater than INT_MAX: " + std::to_string(INT_MAX));
+            }
+            int libusbBulkTransfered = 0;
+            int libusbError = bulkTransfer(endpoint, data, (int) size, &libusbBulkTransfered, timeout, deadline, token);
+            if (libusbError) {
+                const char* libusbErrorName = libusb_error_name(libusbError);
+                throw TransferError(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'", libusbError, (size_t) std::max(libusbBulkTransfered, 0));
+            }
+            if (libusbBulkTransfered < 0) {
+                throw std::runtime_error(CALL_INFO + ": libusbBulkTransfered: " + std::to_string(libusbBulkTransfered) + " less zero");
+            }
+            size_t result = (size_t) libusbBulkTransfered;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
 
-            libusb_device_descriptor libusbDeviceDescriptor = {0};
-            int libusbError = libusb_get_device_descriptor(libusbDevice, &libusbDeviceDescriptor);
+    size_t Client::read(uint8_t* data, size_t capacity, uint8_t endpoint, uint32_t timeout, const std::optional<std::chrono::steady_clock::time_point>& deadline, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            int length = capacity > INT_MAX ? INT_MAX : (int) capacity;
+            int libusbBulkTransfered = 0;
+            int libusbError = bulkTransfer(endpoint, data, length, &libusbBulkTransfered, timeout, deadline, token);
             if (libusbError) {
                 const char* libusbErrorName = libusb_error_name(libusbError);
-                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                throw TransferError(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'", libusbError, (size_t) std::max(libusbBulkTransfered, 0));
             }
+            if (libusbBulkTransfered < 0) {
+                throw std::runtime_error(CALL_INFO + ": libusbBulkTransfered: " + std::to_string(libusbBulkTransfered) + " less zero");
+            }
+            size_t result = (size_t) libusbBulkTransfered;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
 
-            uint16_t vendor = libusbDeviceDescriptor.idVendor;
-            uint16_t product = libusbDeviceDescriptor.idProduct;
-            uint16_t port = libusb_get_port_number(libusbDevice);
-            uint16_t bus = libusb_get_bus_number(libusbDevice);
-            uint16_t address = libusb_get_device_address(libusbDevice);
+    int Client::bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::optional<std::chrono::steady_clock::time_point>& deadline, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            EXQUDENS_USB_PROBE2(transfer_submit, (int) endpoint, (int) length);
+            // the clock is only read while the timeline records or a tracer is attached to 'transfer_complete'
+            bool recording = timeline.isEnabled();
+            bool timed = recording || EXQUDENS_USB_PROBE_ENABLED(transfer_complete);
+            uint64_t transferSequence = recording ? ++sequence : 0;
+            std::chrono::steady_clock::time_point start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+            int libusbError = LIBUSB_ERROR_NO_DEVICE;
+            *transferred = 0;
+            // a call with a deadline bounds the reconnect and the retry by it, otherwise the retry gets the full 'timeout'
+            auto toReconnectDeadline = [&deadline](uint32_t reconnectTimeout) {
+                std::chrono::steady_clock::time_point result = std::chrono::steady_clock::now() + std::chrono::milliseconds(reconnectTimeout);
+                return deadline ? std::min(result, deadline.value()) : result;
+            };
+            if (!reconnecting || reconnect(toReconnectDeadline(getReconnect().value_or(0)), {}, token)) {
+                uint64_t transferConnection = connection;
+                libusbError = transport->bulkTransfer(endpoint, data, length, transferred, timeout, token);
+                if (libusbError == LIBUSB_ERROR_NO_DEVICE) {
+                    std::map<std::string, uint16_t> lost = getDevice();
+                    {
+                        std::lock_guard<std::mutex> lock(stringsMutex);
+                        strings.erase(lost);
+                    }
+                    std::optional<uint32_t> currentReconnect = getReconnect();
+                    if (currentReconnect && reconnect(toReconnectDeadline(currentReconnect.value()), transferConnection, token)) {
+                        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                        if (token && token->isCancelled()) {
+                            libusbError = LIBUSB_ERROR_INTERRUPTED;
+                        } else if (deadline && deadline.value() <= now) {
+                            libusbError = LIBUSB_ERROR_TIMEOUT;
+                        } else {
+                            uint32_t retryTimeout = deadline ? (uint32_t) std::chrono::ceil<std::chrono::milliseconds>(deadline.value() - now).count() : timeout;
+                            libusbError = transport->bulkTransfer(endpoint, data, length, transferred, retryTimeout, token);
+                        }
+                    }
+                }
+            }
+            std::chrono::steady_clock::time_point end = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+            if (EXQUDENS_USB_PROBE_ENABLED(transfer_complete)) {
+                int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                EXQUDENS_USB_PROBE4(transfer_complete, (int) endpoint, (int) *transferred, libusbError, duration);
+            }
+            if (recording) {
+                TransferInfo info = {};
+                info.sequence = transferSequence;
+                info.endpoint = endpoint;
+                info.requested = (size_t) length;
+                info.transferred = (size_t) std::max(*transferred, 0);
+                info.libusbError = libusbError;
+                info.submittedAt = start;
+                info.completedAt = end;
+                timeline.add(info);
+                lastTransfer = {id, info};
+            }
+            return libusbError;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
 
-            result.insert({"vendor", vendor});
-            result.insert({"product", product});
-            result.insert({"port", port});
-            result.insert({"bus", bus});
-            result.insert({"address", address});
+    bool Client::reconnect(
+        const std::chrono::steady_clock::time_point& deadline,
+        const std::optional<uint64_t>& lostConnection,
+        const std::shared_ptr<CancellationToken>& token
+    ) {
+        try {
+            // waits are sliced so a cancelled token is seen within one slice
+            auto toSliceEnd = [&deadline]() {
+                return std::min(deadline, std::chrono::steady_clock::now() + RECONNECT_POLL_INTERVAL);
+            };
+            auto isCancelled = [&token]() {
+                return token && token->isCancelled();
+            };
+
+            // the deadline also bounds the wait for a concurrent reconnect
+            std::unique_lock<std::timed_mutex> reconnectLock(reconnectMutex, std::defer_lock);
+            while (!reconnectLock.try_lock_until(toSliceEnd())) {
+                if (isCancelled() || std::chrono::steady_clock::now() >= deadline) {
+                    return false;
+                }
+            }
 
-            return result;
+            std::map<std::string, uint16_t> lost = {};
+            std::optional<int32_t> lostInterfaceNumber = {};
+            std::optional<bool> lostDetachKernelDriver = {};
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                lost = device;
+                lostInterfaceNumber = interfaceNumber;
+                lostDetachKernelDriver = detachKernelDriver;
+            }
+
+            if (lostConnection) {
+                if (lostConnection.value() != connection || lost.empty()) {
+                    // reopened by a concurrent transfer meanwhile (or closed by the user)
+                    return !reconnecting && isOpen();
+                }
+                log(__FILE__, __LINE__, __FUNCTION__, LOGGER_ID, LOGGER_LEVEL_DEBUG, "lost device: " + toString(lost));
+                reconnecting = true;
+            } else if (!reconnecting) {
+                return isOpen();
+            }
+
+            if (transport->isOpen()) {
+                try {
+                    transport->close();
+                } catch (const std::exception& e) {
+                    log(__FILE__, __LINE__, __FUNCTION__, LOGGER_ID, LOGGER_LEVEL_DEBUG, "close lost device: '" + std::string(e.what()) + "'");
+                }
+            }
+
+            // the device may be reported before it can be opened (e.g. permissions not applied yet), so retry until the deadline
+            while (true) {
+                if (isCancelled()) {
+                    return false;
+                }
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                std::chrono::steady_clock::time_point sliceEnd = toSliceEnd();
+                uint32_t remaining = now >= sliceEnd ? 0 : (uint32_t) std::chrono::ceil<std::chrono::milliseconds>(sliceEnd - now).count();
+                std::map<std::string, uint16_t> found = transport->waitForDevice(lost, remaining);
+                if (found.empty()) {
+                    if (std::chrono::steady_clock::now() >= deadline) {
+                        return false;
+                    }
+                    continue;
+                }
+                try {
+                    transport->open(found, lostInterfaceNumber.value_or(0), lostDetachKernelDriver);
+                    log(__FILE__, __LINE__, __FUNCTION__, LOGGER_ID, LOGGER_LEVEL_DEBUG, "reconnected device: " + toString(found));
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        device = found;
+                    }
+                    connection++;
+                    reconnecting = false;
+                    return true;
+                } catch (const std::exception& e) {
+                    if (std::chrono::steady_clock::now() >= deadline) {
+                        return false;
+                    }
+                    log(__FILE__, __LINE__, __FUNCTION__, LOGGER_ID, LOGGER_LEVEL_DEBUG, "reopen device: '" + std::string(e.what()) + "'");
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<uint32_t> Client::getReconnect() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return reconnectTimeout;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint32_t Client::toTimeout(const std::chrono::steady_clock::time_point& deadline) {
+        try {
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (deadline <= now) {
+                const char* libusbErrorName = libusb_error_name(LIBUSB_ERROR_TIMEOUT);
+                throw TransferError(CALL_INFO + ": deadline passed libusbErrorName: '" + std::string(libusbErrorName) + "'", LIBUSB_ERROR_TIMEOUT, 0);
+            }
+            // rounded up: a zero libusb timeout means unlimited
+            int64_t result = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+            return result > UINT32_MAX ? UINT32_MAX : (uint32_t) result;
         } catch (...) {
             std::throw_with_nested(std::runtime_error(CALL_INFO));
         }
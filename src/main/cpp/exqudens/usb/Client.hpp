@@ -1,10 +1,14 @@
 #pragma once
 
 #include <cstddef>
-
-#include <libusb.h>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <mutex>
 
 #include "exqudens/usb/IClient.hpp"
+#include "exqudens/usb/ITransport.hpp"
+#include "exqudens/usb/TransferTimeline.hpp"
 
 namespace exqudens::usb {
 
@@ -26,14 +30,36 @@ namespace exqudens::usb {
             )> logFunction;
             bool autoInit = false;
             bool autoClose = false;
+            uint64_t id = 0; //!< Unique per instance, unlike the address it is never reused by a later client.
+            std::mutex mutex = {}; //!< Guards 'device', 'interfaceNumber', 'detachKernelDriver' and 'reconnectTimeout'.
             std::map<std::string, uint16_t> device = {};
-            libusb_context* context = nullptr;
-            bool attachKernelDriver = false;
             std::optional<int32_t> interfaceNumber = {};
-            libusb_device_handle* handle = nullptr;
+            std::optional<bool> detachKernelDriver = {};
+            std::optional<uint32_t> reconnectTimeout = {};
+            std::timed_mutex reconnectMutex = {};
+            std::atomic<bool> reconnecting = false;
+            std::atomic<uint64_t> connection = 0; //!< Incremented on every (re)open, tells a transfer whether its device was reopened meanwhile.
+            std::shared_ptr<ITransport> transport = nullptr;
+            std::mutex stringsMutex = {};
+            std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> strings = {};
+            TransferTimeline timeline = {};
+            std::atomic<uint64_t> sequence = 0;
 
         public:
 
+            Client(
+                bool autoInit,
+                bool autoClose,
+                const std::function<void(
+                    const std::string& file,
+                    size_t line,
+                    const std::string& function,
+                    const std::string& id,
+                    uint16_t level,
+                    const std::string& message
+                )>& logFunction,
+                const std::shared_ptr<ITransport>& transport
+            );
             Client(
                 bool autoInit,
                 bool autoClose,
@@ -52,6 +78,8 @@ namespace exqudens::usb {
             );
             Client();
 
+            std::shared_ptr<ITransport> getTransport();
+
             std::string getLoggerId() override;
 
             void setLogFunction(
@@ -74,6 +102,13 @@ namespace exqudens::usb {
             std::string getVersion() override;
 
             std::vector<std::map<std::string, uint16_t>> listDevices() override;
+            std::vector<std::map<std::string, uint16_t>> listDevices(const DeviceFilter& filter) override;
+
+            std::optional<std::string> getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) override;
+
+            size_t loadDescriptorCache(const std::string& path) override;
+
+            void saveDescriptorCache(const std::string& path) override;
 
             std::string toString(const std::map<std::string, uint16_t>& value) override;
 
@@ -84,18 +119,51 @@ namespace exqudens::usb {
 
             std::map<std::string, uint16_t> getDevice() override;
 
+            void setReconnect(const std::optional<uint32_t>& timeout) override;
+
+            bool isReconnecting() override;
+
+            bool reconnect(uint32_t timeout) override;
+
+            void setTimelineCapacity(size_t capacity) override;
+
+            std::vector<TransferInfo> getTimeline() override;
+
+            std::optional<TransferInfo> getLastTransfer() override;
+
+            std::vector<std::string> tuneCurrentThread() override;
+
+            std::vector<std::string> getThreadErrors() override;
+
+            Buffer allocateBuffer(size_t capacity) override;
+
             uint8_t toWriteEndpoint(uint8_t endpoint) override;
             uint8_t toReadEndpoint(uint8_t endpoint) override;
 
+            using IClient::bulkWrite;
+            using IClient::bulkRead;
+
             size_t bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) override;
             size_t bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout) override;
             size_t bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint) override;
 
+            size_t bulkWrite(const Buffer& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) override;
+            size_t bulkWrite(const Buffer& value, uint8_t endpoint, uint32_t timeout) override;
+
+            size_t bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) override;
+            size_t bulkWrite(const Buffer& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) override;
+
             std::vector<uint8_t> bulkRead(uint8_t endpoint, uint32_t timeout, int32_t size, bool autoEndpointDirection) override;
             std::vector<uint8_t> bulkRead(uint8_t endpoint, uint32_t timeout, int32_t size) override;
             std::vector<uint8_t> bulkRead(uint8_t endpoint, uint32_t timeout) override;
             std::vector<uint8_t> bulkRead(uint8_t endpoint) override;
 
+            size_t bulkRead(Buffer& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) override;
+            size_t bulkRead(Buffer& value, uint8_t endpoint, uint32_t timeout) override;
+
+            std::vector<uint8_t> bulkRead(uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, int32_t size, const std::shared_ptr<CancellationToken>& token) override;
+            size_t bulkRead(Buffer& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) override;
+
             void close() override;
 
             void destroy() override;
@@ -104,7 +172,26 @@ namespace exqudens::usb {
 
         private:
 
-            std::map<std::string, uint16_t> toMap(libusb_device* libusbDevice);
+            size_t write(uint8_t* data, size_t size, uint8_t endpoint, uint32_t timeout, const std::optional<std::chrono::steady_clock::time_point>& deadline, const std::shared_ptr<CancellationToken>& token);
+
+            size_t read(uint8_t* data, size_t capacity, uint8_t endpoint, uint32_t timeout, const std::optional<std::chrono::steady_clock::time_point>& deadline, const std::shared_ptr<CancellationToken>& token);
+
+            /*!
+            * Reconnects once for all threads, a thread arriving while another one reconnects waits for its result.
+            * With 'lostConnection' the caller lost the device of that connection, nothing is done if it was already reopened.
+            * Gives up at 'deadline' or once 'token' is cancelled.
+            */
+            bool reconnect(
+                const std::chrono::steady_clock::time_point& deadline,
+                const std::optional<uint64_t>& lostConnection,
+                const std::shared_ptr<CancellationToken>& token
+            );
+
+            std::optional<uint32_t> getReconnect();
+
+            int bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::optional<std::chrono::steady_clock::time_point>& deadline, const std::shared_ptr<CancellationToken>& token);
+
+            uint32_t toTimeout(const std::chrono::steady_clock::time_point& deadline);
 
             void log(
                 const std::string& file,
@@ -3,11 +3,33 @@
 
 #include "exqudens/usb/ClientFactory.hpp"
 #include "exqudens/usb/Client.hpp"
+#include "exqudens/usb/LibusbTransport.hpp"
 
 #define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
 
 namespace exqudens::usb {
 
+    std::shared_ptr<IClient> ClientFactory::createShared(
+        const bool& autoInit,
+        const bool& autoClose,
+        const std::function<void(
+            const std::string& file,
+            const size_t& line,
+            const std::string& function,
+            const std::string& id,
+            const unsigned short& level,
+            const std::string& message
+        )>& logFunction,
+        const std::shared_ptr<ITransport>& transport
+    ) {
+        try {
+            std::shared_ptr<IClient> result(new Client(autoInit, autoClose, logFunction, transport));
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     std::shared_ptr<IClient> ClientFactory::createShared(
         const bool& autoInit,
         const bool& autoClose,
@@ -28,6 +50,26 @@ namespace exqudens::usb {
         }
     }
 
+    std::shared_ptr<IClient> ClientFactory::createShared(
+        const bool& autoInit,
+        const bool& autoClose,
+        const std::function<void(
+            const std::string& file,
+            const size_t& line,
+            const std::string& function,
+            const std::string& id,
+            const unsigned short& level,
+            const std::string& message
+        )>& logFunction,
+        const ThreadOptions& threadOptions
+    ) {
+        try {
+            return createShared(autoInit, autoClose, logFunction, std::make_shared<LibusbTransport>(threadOptions));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
     std::shared_ptr<IClient> ClientFactory::createShared(
         const bool& autoInit,
         const bool& autoClose
@@ -47,6 +89,95 @@ namespace exqudens::usb {
         }
     }
 
+    std::shared_ptr<IClient> ClientFactory::createSimulatedShared(
+        const bool& autoInit,
+        const bool& autoClose,
+        const std::function<void(
+            const std::string& file,
+            const size_t& line,
+            const std::string& function,
+            const std::string& id,
+            const unsigned short& level,
+            const std::string& message
+        )>& logFunction,
+        const SimulatedTransport::Options& options
+    ) {
+        try {
+            return createShared(autoInit, autoClose, logFunction, std::make_shared<SimulatedTransport>(options));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> ClientFactory::createSimulatedShared(
+        const SimulatedTransport::Options& options
+    ) {
+        try {
+            return createSimulatedShared(true, true, {}, options);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> ClientFactory::createSharedMemoryShared(
+        const std::string& name
+    ) {
+        try {
+            return createShared(true, true, {}, std::make_shared<SharedMemoryTransport>(name));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<ClientPool> ClientFactory::createPoolShared(
+        const std::function<std::shared_ptr<IClient>()>& clientFunction,
+        const std::chrono::milliseconds& idleTimeout
+    ) {
+        try {
+            return std::make_shared<ClientPool>(clientFunction, idleTimeout);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<ClientPool> ClientFactory::createPoolShared(
+        const std::chrono::milliseconds& idleTimeout
+    ) {
+        try {
+            return createPoolShared([]() { return createShared(true, true); }, idleTimeout);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<DeviceGroup> ClientFactory::createGroupShared(
+        const std::vector<std::shared_ptr<IClient>>& clients
+    ) {
+        try {
+            return std::make_shared<DeviceGroup>(clients);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<DeviceIndex> ClientFactory::createIndexShared(
+        const std::function<std::shared_ptr<IClient>()>& clientFunction
+    ) {
+        try {
+            return std::make_shared<DeviceIndex>(clientFunction);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<DeviceIndex> ClientFactory::createIndexShared() {
+        try {
+            return createIndexShared([]() { return createShared(true, true); });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
 }
 
 #undef CALL_INFO
@@ -1,8 +1,16 @@
 #pragma once
 
 #include <memory>
+#include <chrono>
 
 #include "exqudens/usb/IClient.hpp"
+#include "exqudens/usb/ITransport.hpp"
+#include "exqudens/usb/SimulatedTransport.hpp"
+#include "exqudens/usb/SharedMemoryTransport.hpp"
+#include "exqudens/usb/ThreadOptions.hpp"
+#include "exqudens/usb/ClientPool.hpp"
+#include "exqudens/usb/DeviceGroup.hpp"
+#include "exqudens/usb/DeviceIndex.hpp"
 
 namespace exqudens::usb {
 
@@ -10,6 +18,20 @@ namespace exqudens::usb {
 
         public:
 
+            static std::shared_ptr<IClient> createShared(
+                const bool& autoInit,
+                const bool& autoClose,
+                const std::function<void(
+                    const std::string& file,
+                    const size_t& line,
+                    const std::string& function,
+                    const std::string& id,
+                    const unsigned short& level,
+                    const std::string& message
+                )>& logFunction,
+                const std::shared_ptr<ITransport>& transport
+            );
+
             static std::shared_ptr<IClient> createShared(
                 const bool& autoInit,
                 const bool& autoClose,
@@ -23,6 +45,24 @@ namespace exqudens::usb {
                 )>& logFunction
             );
 
+            /*!
+            * Creates a libusb client with 'threadOptions', a thread doing the transfers applies them to itself
+            * with 'IClient::tuneCurrentThread', 'spinBudget' applies to every transfer.
+            */
+            static std::shared_ptr<IClient> createShared(
+                const bool& autoInit,
+                const bool& autoClose,
+                const std::function<void(
+                    const std::string& file,
+                    const size_t& line,
+                    const std::string& function,
+                    const std::string& id,
+                    const unsigned short& level,
+                    const std::string& message
+                )>& logFunction,
+                const ThreadOptions& threadOptions
+            );
+
             static std::shared_ptr<IClient> createShared(
                 const bool& autoInit,
                 const bool& autoClose
@@ -30,6 +70,50 @@ namespace exqudens::usb {
 
             static std::shared_ptr<IClient> createShared();
 
+            static std::shared_ptr<IClient> createSimulatedShared(
+                const bool& autoInit,
+                const bool& autoClose,
+                const std::function<void(
+                    const std::string& file,
+                    const size_t& line,
+                    const std::string& function,
+                    const std::string& id,
+                    const unsigned short& level,
+                    const std::string& message
+                )>& logFunction,
+                const SimulatedTransport::Options& options
+            );
+
+            static std::shared_ptr<IClient> createSimulatedShared(
+                const SimulatedTransport::Options& options
+            );
+
+            /*!
+            * Creates a client of the device served by the 'SharedMemoryServer' named 'name'.
+            */
+            static std::shared_ptr<IClient> createSharedMemoryShared(
+                const std::string& name
+            );
+
+            static std::shared_ptr<ClientPool> createPoolShared(
+                const std::function<std::shared_ptr<IClient>()>& clientFunction,
+                const std::chrono::milliseconds& idleTimeout
+            );
+
+            static std::shared_ptr<ClientPool> createPoolShared(
+                const std::chrono::milliseconds& idleTimeout
+            );
+
+            static std::shared_ptr<DeviceGroup> createGroupShared(
+                const std::vector<std::shared_ptr<IClient>>& clients
+            );
+
+            static std::shared_ptr<DeviceIndex> createIndexShared(
+                const std::function<std::shared_ptr<IClient>()>& clientFunction
+            );
+
+            static std::shared_ptr<DeviceIndex> createIndexShared();
+
     };
 
 }
@@ -0,0 +1,292 @@
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/ClientPool.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    ClientPool::Lease::Lease(
+        const std::shared_ptr<ClientPool>& pool,
+        const std::shared_ptr<IClient>& client,
+        const std::map<std::string, uint16_t>& device,
+        int32_t interfaceNumber
+    ):
+        pool(pool),
+        client(client),
+        device(device),
+        interfaceNumber(interfaceNumber)
+    {
+    }
+
+    ClientPool::Lease::Lease() = default;
+
+    ClientPool::Lease::Lease(Lease&& other) noexcept:
+        pool(std::exchange(other.pool, nullptr)),
+        client(std::exchange(other.client, nullptr)),
+        device(std::exchange(other.device, {})),
+        interfaceNumber(std::exchange(other.interfaceNumber, 0)),
+        valid(std::exchange(other.valid, true))
+    {
+    }
+
+    ClientPool::Lease& ClientPool::Lease::operator=(Lease&& other) noexcept {
+        if (this != &other) {
+            release();
+            pool = std::exchange(other.pool, nullptr);
+            client = std::exchange(other.client, nullptr);
+            device = std::exchange(other.device, {});
+            interfaceNumber = std::exchange(other.interfaceNumber, 0);
+            valid = std::exchange(other.valid, true);
+        }
+        return *this;
+    }
+
+    IClient* ClientPool::Lease::operator->() {
+        try {
+            if (!client) {
+                throw std::runtime_error(CALL_INFO + ": lease is released!");
+            }
+            return client.get();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> ClientPool::Lease::getClient() {
+        try {
+            return client;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void ClientPool::Lease::invalidate() {
+        try {
+            valid = false;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void ClientPool::Lease::release() noexcept {
+        if (pool && client) {
+            pool->release(client, device, interfaceNumber, valid);
+        }
+        pool = nullptr;
+        client = nullptr;
+        device = {};
+        interfaceNumber = 0;
+        valid = true;
+    }
+
+    ClientPool::Lease::~Lease() noexcept {
+        release();
+    }
+
+    ClientPool::ClientPool(
+        const std::function<std::shared_ptr<IClient>()>& clientFunction,
+        const std::chrono::milliseconds& idleTimeout,
+        const std::function<bool(const std::shared_ptr<IClient>& client)>& healthCheckFunction
+    ):
+        clientFunction(clientFunction),
+        idleTimeout(idleTimeout),
+        healthCheckFunction(healthCheckFunction)
+    {
+        if (!clientFunction) {
+            throw std::runtime_error(CALL_INFO + ": clientFunction is empty!");
+        }
+    }
+
+    ClientPool::ClientPool(
+        const std::function<std::shared_ptr<IClient>()>& clientFunction,
+        const std::chrono::milliseconds& idleTimeout
+    ): ClientPool(clientFunction, idleTimeout, {}) {}
+
+    ClientPool::Lease ClientPool::acquire(
+        const std::map<std::string, uint16_t>& device,
+        const std::optional<int32_t>& interfaceNumber,
+        const std::optional<bool>& detachKernelDriver,
+        const std::chrono::milliseconds& timeout
+    ) {
+        try {
+            if (device.empty()) {
+                throw std::runtime_error(CALL_INFO + ": device is empty!");
+            }
+
+            close(removeIdle(false));
+
+            std::pair<std::map<std::string, uint16_t>, int32_t> key = {device, interfaceNumber.value_or(0)};
+            std::unique_lock<std::mutex> lock(mutex);
+            bool available = condition.wait_for(lock, timeout, [this, &key]() {
+                auto entry = entries.find(key);
+                return entry == entries.end() || !entry->second.leased;
+            });
+            if (!available) {
+                throw std::runtime_error(CALL_INFO + ": device is leased: timeout: " + std::to_string(timeout.count()) + " ms");
+            }
+
+            Entry& entry = entries[key];
+            entry.leased = true;
+            if (entry.client) {
+                return Lease(shared_from_this(), entry.client, key.first, key.second);
+            }
+            lock.unlock();
+
+            // open outside the lock, the reserved entry keeps other callers waiting for this key
+            try {
+                std::shared_ptr<IClient> client = clientFunction();
+                client->open(device, interfaceNumber, detachKernelDriver);
+                lock.lock();
+                entries[key].client = client;
+                return Lease(shared_from_this(), client, key.first, key.second);
+            } catch (...) {
+                if (!lock.owns_lock()) {
+                    lock.lock();
+                }
+                entries.erase(key);
+                lock.unlock();
+                condition.notify_all();
+                throw;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    ClientPool::Lease ClientPool::acquire(const std::map<std::string, uint16_t>& device) {
+        try {
+            return acquire(device, {}, {}, std::chrono::milliseconds(1000));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t ClientPool::evictIdle() {
+        try {
+            std::vector<std::shared_ptr<IClient>> clients = removeIdle(false);
+            close(clients);
+            return clients.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t ClientPool::getIdleSize() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t result = 0;
+            for (const auto& [key, entry] : entries) {
+                if (!entry.leased) {
+                    result++;
+                }
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t ClientPool::getLeasedSize() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t result = 0;
+            for (const auto& [key, entry] : entries) {
+                if (entry.leased) {
+                    result++;
+                }
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void ClientPool::clear() {
+        try {
+            close(removeIdle(true));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    ClientPool::~ClientPool() noexcept {
+        std::vector<std::shared_ptr<IClient>> clients = {};
+        for (const auto& [key, entry] : entries) {
+            if (entry.client) {
+                clients.emplace_back(entry.client);
+            }
+        }
+        entries.clear();
+        close(clients);
+    }
+
+    void ClientPool::release(
+        const std::shared_ptr<IClient>& client,
+        const std::map<std::string, uint16_t>& device,
+        int32_t interfaceNumber,
+        bool valid
+    ) noexcept {
+        bool healthy = false;
+        try {
+            if (valid) {
+                healthy = healthCheckFunction ? healthCheckFunction(client) : client->isOpen();
+            }
+        } catch (...) {
+            healthy = false;
+        }
+        try {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto entry = entries.find({device, interfaceNumber});
+            if (entry != entries.end()) {
+                if (healthy) {
+                    entry->second.leased = false;
+                    entry->second.releasedAt = std::chrono::steady_clock::now();
+                } else {
+                    entries.erase(entry);
+                }
+            }
+        } catch (...) {
+            healthy = false;
+        }
+        condition.notify_all();
+        if (!healthy) {
+            close({client});
+        }
+    }
+
+    std::vector<std::shared_ptr<IClient>> ClientPool::removeIdle(bool all) {
+        try {
+            std::vector<std::shared_ptr<IClient>> result = {};
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto entry = entries.begin(); entry != entries.end();) {
+                if (!entry->second.leased && (all || now - entry->second.releasedAt >= idleTimeout)) {
+                    result.emplace_back(entry->second.client);
+                    entry = entries.erase(entry);
+                } else {
+                    entry++;
+                }
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void ClientPool::close(const std::vector<std::shared_ptr<IClient>>& clients) noexcept {
+        for (const std::shared_ptr<IClient>& client : clients) {
+            try {
+                if (client && client->isOpen()) {
+                    client->close();
+                }
+            } catch (...) {
+            }
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Keeps opened clients keyed by device and interface number and leases them out exclusively.
+    * Returned clients are health checked, idle ones are closed after 'idleTimeout'.
+    */
+    class EXQUDENS_USB_EXPORT ClientPool: public std::enable_shared_from_this<ClientPool> {
+
+        public:
+
+            class EXQUDENS_USB_EXPORT Lease {
+
+                private:
+
+                    std::shared_ptr<ClientPool> pool = nullptr;
+                    std::shared_ptr<IClient> client = nullptr;
+                    std::map<std::string, uint16_t> device = {};
+                    int32_t interfaceNumber = 0;
+                    bool valid = true;
+
+                public:
+
+                    Lease(
+                        const std::shared_ptr<ClientPool>& pool,
+                        const std::shared_ptr<IClient>& client,
+                        const std::map<std::string, uint16_t>& device,
+                        int32_t interfaceNumber
+                    );
+                    Lease();
+                    Lease(const Lease& other) = delete;
+                    Lease(Lease&& other) noexcept;
+
+                    Lease& operator=(const Lease& other) = delete;
+                    Lease& operator=(Lease&& other) noexcept;
+
+                    IClient* operator->();
+
+                    std::shared_ptr<IClient> getClient();
+
+                    /*!
+                    * Marks the client as broken, it is closed instead of returned to the pool.
+                    */
+                    void invalidate();
+
+                    void release() noexcept;
+
+                    ~Lease() noexcept;
+
+            };
+
+        private:
+
+            struct Entry {
+                std::shared_ptr<IClient> client = nullptr;
+                bool leased = false;
+                std::chrono::steady_clock::time_point releasedAt = {};
+            };
+
+            std::function<std::shared_ptr<IClient>()> clientFunction = {};
+            std::chrono::milliseconds idleTimeout = std::chrono::milliseconds(0);
+            std::function<bool(const std::shared_ptr<IClient>& client)> healthCheckFunction = {};
+            std::mutex mutex = {};
+            std::condition_variable condition = {};
+            std::map<std::pair<std::map<std::string, uint16_t>, int32_t>, Entry> entries = {};
+
+        public:
+
+            ClientPool(
+                const std::function<std::shared_ptr<IClient>()>& clientFunction, //!< Creates initialized, not open clients.
+                const std::chrono::milliseconds& idleTimeout,
+                const std::function<bool(const std::shared_ptr<IClient>& client)>& healthCheckFunction //!< Empty to check 'isOpen' only.
+            );
+            ClientPool(
+                const std::function<std::shared_ptr<IClient>()>& clientFunction,
+                const std::chrono::milliseconds& idleTimeout
+            );
+
+            /*!
+            * Leases the open client for the device, opening it on first use.
+            * Waits up to 'timeout' while the device is leased by someone else.
+            *
+            * @throws std::runtime_error
+            */
+            Lease acquire(
+                const std::map<std::string, uint16_t>& device,
+                const std::optional<int32_t>& interfaceNumber,
+                const std::optional<bool>& detachKernelDriver,
+                const std::chrono::milliseconds& timeout
+            );
+
+            Lease acquire(const std::map<std::string, uint16_t>& device);
+
+            /*!
+            * Closes clients idle for longer than 'idleTimeout'.
+            *
+            * @return A number of closed clients.
+            */
+            size_t evictIdle();
+
+            size_t getIdleSize();
+
+            size_t getLeasedSize();
+
+            /*!
+            * Closes every idle client.
+            */
+            void clear();
+
+            ~ClientPool() noexcept;
+
+        private:
+
+            void release(
+                const std::shared_ptr<IClient>& client,
+                const std::map<std::string, uint16_t>& device,
+                int32_t interfaceNumber,
+                bool valid
+            ) noexcept;
+
+            std::vector<std::shared_ptr<IClient>> removeIdle(bool all);
+
+            static void close(const std::vector<std::shared_ptr<IClient>>& clients) noexcept;
+
+    };
+
+}
@@ -0,0 +1,223 @@
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/CoalescingWriter.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    CoalescingWriter::CoalescingWriter(
+        const std::shared_ptr<IClient>& client,
+        uint8_t endpoint,
+        uint32_t timeout,
+        size_t threshold,
+        const std::chrono::microseconds& linger
+    ):
+        client(client),
+        endpoint(endpoint),
+        timeout(timeout),
+        threshold(threshold),
+        linger(linger)
+    {
+        try {
+            if (!this->client) {
+                throw std::runtime_error(CALL_INFO + ": client is null!");
+            }
+            if (threshold == 0) {
+                throw std::runtime_error(CALL_INFO + ": threshold must be greater zero!");
+            }
+            pending.reserve(threshold);
+            sending.reserve(threshold);
+            if (linger.count() > 0) {
+                thread = std::thread(&CoalescingWriter::run, this);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CoalescingWriter::write(const uint8_t* data, size_t size) {
+        try {
+            throwError();
+
+            if (size >= threshold) {
+                std::vector<uint8_t> value(data, data + size);
+                std::lock_guard<std::mutex> transferLock(transferMutex);
+                drain();
+                messageCount++;
+                send(value);
+                return;
+            }
+
+            bool first = false;
+            bool full = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (pending.empty()) {
+                    pendingAt = std::chrono::steady_clock::now();
+                    first = true;
+                }
+                pending.insert(pending.end(), data, data + size);
+                messageCount++;
+                full = pending.size() >= threshold;
+            }
+            if (full) {
+                std::lock_guard<std::mutex> transferLock(transferMutex);
+                drain();
+            } else if (first && thread.joinable()) {
+                condition.notify_all();
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CoalescingWriter::write(const std::vector<uint8_t>& value) {
+        try {
+            write(value.data(), value.size());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CoalescingWriter::flush() {
+        try {
+            throwError();
+            std::lock_guard<std::mutex> transferLock(transferMutex);
+            drain();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t CoalescingWriter::getPendingSize() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return pending.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t CoalescingWriter::getMessageCount() {
+        try {
+            return messageCount.load();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t CoalescingWriter::getTransferCount() {
+        try {
+            return transferCount.load();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    CoalescingWriter::~CoalescingWriter() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+        try {
+            std::lock_guard<std::mutex> transferLock(transferMutex);
+            drain();
+        } catch (...) {
+        }
+    }
+
+    void CoalescingWriter::run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopped) {
+            if (pending.empty()) {
+                condition.wait(lock, [this]() { return stopped || !pending.empty(); });
+                continue;
+            }
+            std::chrono::steady_clock::time_point due = pendingAt + linger;
+            if (std::chrono::steady_clock::now() < due) {
+                condition.wait_until(lock, due);
+                continue;
+            }
+            lock.unlock();
+            try {
+                std::lock_guard<std::mutex> transferLock(transferMutex);
+                drain();
+                lock.lock();
+            } catch (...) {
+                lock.lock();
+                if (!error) {
+                    error = std::current_exception();
+                    failed = true;
+                }
+            }
+        }
+    }
+
+    void CoalescingWriter::drain() {
+        try {
+            // 'transferMutex' is held, writers keep appending to 'pending' during the transfer
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (pending.empty()) {
+                    return;
+                }
+                sending.swap(pending);
+            }
+            send(sending);
+            sending.clear();
+        } catch (...) {
+            sending.clear();
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CoalescingWriter::send(const std::vector<uint8_t>& value) {
+        try {
+            size_t written = 0;
+            while (written < value.size()) {
+                size_t size = 0;
+                if (written == 0) {
+                    size = client->bulkWrite(value, endpoint, timeout, false);
+                } else {
+                    size = client->bulkWrite(std::vector<uint8_t>(value.begin() + (std::ptrdiff_t) written, value.end()), endpoint, timeout, false);
+                }
+                transferCount++;
+                if (size == 0) {
+                    throw std::runtime_error(CALL_INFO + ": nothing written of: " + std::to_string(value.size() - written) + " bytes");
+                }
+                written += size;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CoalescingWriter::throwError() {
+        try {
+            if (!failed.load()) {
+                return;
+            }
+            std::exception_ptr value = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::swap(value, error);
+                failed = false;
+            }
+            if (value) {
+                std::rethrow_exception(value);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO + ": timer flush failed"));
+        }
+    }
+
+}
+
+#undef CALL_INFO
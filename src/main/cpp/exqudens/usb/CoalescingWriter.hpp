@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Merges consecutive small writes into bulk transfers of up to 'threshold' bytes (like Nagle / TCP_CORK).
+    * Pending bytes are written when 'threshold' is reached, 'linger' after the first pending byte or on 'flush'.
+    * Thread safe, message order is preserved. An error of a timer flush is thrown by the next call.
+    */
+    class EXQUDENS_USB_EXPORT CoalescingWriter {
+
+        private:
+
+            std::shared_ptr<IClient> client = nullptr;
+            uint8_t endpoint = 0;
+            uint32_t timeout = 0;
+            size_t threshold = 0;
+            std::chrono::microseconds linger = std::chrono::microseconds(0);
+            std::mutex mutex = {};
+            std::mutex transferMutex = {};
+            std::condition_variable condition = {};
+            std::vector<uint8_t> pending = {};
+            std::vector<uint8_t> sending = {};
+            std::chrono::steady_clock::time_point pendingAt = {};
+            std::exception_ptr error = nullptr;
+            std::atomic<bool> failed = false;
+            std::atomic<size_t> messageCount = 0;
+            std::atomic<size_t> transferCount = 0;
+            bool stopped = false;
+            std::thread thread = {};
+
+        public:
+
+            CoalescingWriter(
+                const std::shared_ptr<IClient>& client,
+                uint8_t endpoint, //!< OUT endpoint address, e.g. '0x01'.
+                uint32_t timeout, //!< Per transfer, '0' for unlimited.
+                size_t threshold, //!< Transfer size that triggers a write, usually a multiple of the packet size.
+                const std::chrono::microseconds& linger //!< '0' disables the timer.
+            );
+            CoalescingWriter(const CoalescingWriter& other) = delete;
+
+            CoalescingWriter& operator=(const CoalescingWriter& other) = delete;
+
+            /*!
+            * Queues the message, writes pending bytes when 'threshold' is reached.
+            * Messages not smaller than 'threshold' are written directly after the pending bytes.
+            *
+            * @throws std::runtime_error
+            */
+            void write(const uint8_t* data, size_t size);
+            void write(const std::vector<uint8_t>& value);
+
+            /*!
+            * Writes the pending bytes.
+            *
+            * @throws std::runtime_error
+            */
+            void flush();
+
+            size_t getPendingSize();
+
+            size_t getMessageCount();
+
+            size_t getTransferCount();
+
+            /*!
+            * Stops the timer and writes the pending bytes, errors are ignored.
+            */
+            ~CoalescingWriter() noexcept;
+
+        private:
+
+            void run();
+
+            void drain();
+
+            void send(const std::vector<uint8_t>& value);
+
+            void throwError();
+
+    };
+
+}
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/CompletionDispatcher.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    CompletionDispatcher::CompletionDispatcher(size_t threadCount) {
+        try {
+            size_t count = threadCount > 0 ? threadCount : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            // more shards than workers keeps 'dispatch' from contending on one lock
+            for (size_t i = 0; i < count * 4; i++) {
+                shards.emplace_back(std::make_unique<Shard>());
+            }
+            for (size_t i = 0; i < count; i++) {
+                workers.emplace_back(std::make_unique<Worker>());
+            }
+            for (size_t i = 0; i < count; i++) {
+                threads.emplace_back(&CompletionDispatcher::run, this, i);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    CompletionDispatcher::CompletionDispatcher(): CompletionDispatcher(0) {}
+
+    size_t CompletionDispatcher::getThreadCount() {
+        try {
+            return workers.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CompletionDispatcher::dispatch(size_t key, const std::function<void()>& task) {
+        try {
+            if (!task) {
+                throw std::runtime_error(CALL_INFO + ": task is empty!");
+            }
+
+            size_t depth = ++queueDepth;
+            size_t max = maxQueueDepth.load();
+            while (depth > max && !maxQueueDepth.compare_exchange_weak(max, depth)) {
+            }
+
+            bool schedule = false;
+            {
+                Shard& shard = toShard(key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                Strand& strand = shard.strands[key];
+                strand.tasks.emplace_back(task);
+                schedule = !strand.scheduled;
+                strand.scheduled = true;
+            }
+            if (schedule) {
+                push(key, key % workers.size());
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CompletionDispatcher::waitIdle() {
+        try {
+            std::unique_lock<std::mutex> lock(mutex);
+            idleCondition.wait(lock, [this]() { return queueDepth.load() == 0; });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t CompletionDispatcher::getQueueDepth(size_t key) {
+        try {
+            Shard& shard = toShard(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto strand = shard.strands.find(key);
+            return strand == shard.strands.end() ? 0 : strand->second.tasks.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    CompletionDispatcher::Metrics CompletionDispatcher::getMetrics() {
+        try {
+            Metrics result = {};
+            result.queueDepth = queueDepth.load();
+            result.maxQueueDepth = maxQueueDepth.load();
+            result.completed = completed.load();
+            result.failed = failed.load();
+            result.stolen = stolen.load();
+            for (const std::unique_ptr<Worker>& worker : workers) {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                result.workerQueueDepths.emplace_back(worker->keys.size());
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    CompletionDispatcher::~CompletionDispatcher() noexcept {
+        try {
+            waitIdle();
+        } catch (...) {
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+        for (std::thread& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    void CompletionDispatcher::run(size_t index) {
+        while (true) {
+            std::optional<size_t> key = take(index);
+            if (key) {
+                runStrand(key.value(), index);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopped || ready.load() > 0; });
+            if (stopped && ready.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    std::optional<size_t> CompletionDispatcher::take(size_t index) {
+        try {
+            // own keys oldest first, so a requeued key goes behind the others
+            {
+                Worker& worker = *workers.at(index);
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if (!worker.keys.empty()) {
+                    size_t key = worker.keys.front();
+                    worker.keys.pop_front();
+                    ready--;
+                    return key;
+                }
+            }
+            // steal the newest key of the next non-empty worker
+            for (size_t i = 1; i < workers.size(); i++) {
+                Worker& worker = *workers.at((index + i) % workers.size());
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if (!worker.keys.empty()) {
+                    size_t key = worker.keys.back();
+                    worker.keys.pop_back();
+                    ready--;
+                    stolen++;
+                    return key;
+                }
+            }
+            return {};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CompletionDispatcher::push(size_t key, size_t index) {
+        try {
+            {
+                Worker& worker = *workers.at(index);
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.keys.emplace_back(key);
+                ready++;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+            }
+            condition.notify_one();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void CompletionDispatcher::runStrand(size_t key, size_t index) {
+        Shard& shard = toShard(key);
+        for (size_t i = 0; i <= BATCH_SIZE; i++) {
+            std::function<void()> task = {};
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                Strand& strand = shard.strands[key];
+                if (strand.tasks.empty()) {
+                    shard.strands.erase(key);
+                    return;
+                }
+                if (i == BATCH_SIZE) {
+                    break;
+                }
+                task = std::move(strand.tasks.front());
+                strand.tasks.pop_front();
+            }
+            try {
+                task();
+            } catch (...) {
+                failed++;
+            }
+            completed++;
+            if (--queueDepth == 0) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                }
+                idleCondition.notify_all();
+            }
+        }
+        // the key is still scheduled, let other keys of this worker run first
+        try {
+            push(key, index);
+        } catch (...) {
+        }
+    }
+
+    CompletionDispatcher::Shard& CompletionDispatcher::toShard(size_t key) {
+        try {
+            return *shards.at(key % shards.size());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
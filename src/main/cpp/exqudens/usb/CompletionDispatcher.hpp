@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "exqudens/usb/export.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Hands completed transfers over to a work-stealing thread pool for post-processing.
+    * Tasks dispatched with the same key (e.g. a device index) run one at a time in dispatch order,
+    * tasks of different keys run in parallel. A key is queued on worker 'key % threadCount',
+    * idle workers steal keys from the busy ones.
+    */
+    class EXQUDENS_USB_EXPORT CompletionDispatcher {
+
+        public:
+
+            inline static const size_t BATCH_SIZE = 16; //!< Tasks of one key run before the worker moves on to the next key.
+
+            struct Metrics {
+                size_t queueDepth = 0; //!< Dispatched, not completed tasks.
+                size_t maxQueueDepth = 0;
+                size_t completed = 0;
+                size_t failed = 0; //!< Tasks that threw.
+                size_t stolen = 0; //!< Keys taken from another worker.
+                std::vector<size_t> workerQueueDepths = {}; //!< Keys waiting per worker.
+            };
+
+        private:
+
+            struct Strand {
+                std::deque<std::function<void()>> tasks = {};
+                bool scheduled = false;
+            };
+
+            struct Shard {
+                std::mutex mutex = {};
+                std::unordered_map<size_t, Strand> strands = {};
+            };
+
+            struct Worker {
+                std::mutex mutex = {};
+                std::deque<size_t> keys = {};
+            };
+
+            std::vector<std::unique_ptr<Shard>> shards = {};
+            std::vector<std::unique_ptr<Worker>> workers = {};
+            std::vector<std::thread> threads = {};
+            std::mutex mutex = {};
+            std::condition_variable condition = {};
+            std::condition_variable idleCondition = {};
+            std::atomic<size_t> ready = 0;
+            std::atomic<size_t> queueDepth = 0;
+            std::atomic<size_t> maxQueueDepth = 0;
+            std::atomic<size_t> completed = 0;
+            std::atomic<size_t> failed = 0;
+            std::atomic<size_t> stolen = 0;
+            bool stopped = false;
+
+        public:
+
+            explicit CompletionDispatcher(size_t threadCount); //!< '0' for 'std::thread::hardware_concurrency'.
+            CompletionDispatcher();
+            CompletionDispatcher(const CompletionDispatcher& other) = delete;
+
+            CompletionDispatcher& operator=(const CompletionDispatcher& other) = delete;
+
+            size_t getThreadCount();
+
+            /*!
+            * Queues 'task' behind the previous tasks of 'key'. Exceptions of 'task' are counted in 'Metrics::failed'.
+            *
+            * @throws std::runtime_error
+            */
+            void dispatch(size_t key, const std::function<void()>& task);
+
+            /*!
+            * Waits until every dispatched task is completed.
+            */
+            void waitIdle();
+
+            /*!
+            * @return A number of queued, not yet running tasks of 'key'.
+            */
+            size_t getQueueDepth(size_t key);
+
+            Metrics getMetrics();
+
+            /*!
+            * Completes the queued tasks and stops the workers.
+            */
+            ~CompletionDispatcher() noexcept;
+
+        private:
+
+            void run(size_t index);
+
+            std::optional<size_t> take(size_t index);
+
+            void push(size_t key, size_t index);
+
+            void runStrand(size_t key, size_t index);
+
+            Shard& toShard(size_t key);
+
+    };
+
+}
@@ -0,0 +1,222 @@
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "exqudens/usb/DescriptorCache.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> DescriptorCache::read(const std::string& path) {
+        try {
+            if (!std::filesystem::exists(path)) {
+                return {};
+            }
+#if __has_include(<sys/mman.h>)
+            int file = ::open(path.c_str(), O_RDONLY);
+            if (file < 0) {
+                throw std::runtime_error(CALL_INFO + ": can not open: '" + path + "'");
+            }
+            struct stat fileStat = {};
+            if (fstat(file, &fileStat) != 0) {
+                ::close(file);
+                throw std::runtime_error(CALL_INFO + ": can not stat: '" + path + "'");
+            }
+            size_t size = (size_t) fileStat.st_size;
+            if (size == 0) {
+                ::close(file);
+                return parse(nullptr, 0);
+            }
+            void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            ::close(file);
+            if (data == MAP_FAILED) {
+                throw std::runtime_error(CALL_INFO + ": can not map: '" + path + "'");
+            }
+            try {
+                std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> result = parse((const uint8_t*) data, size);
+                munmap(data, size);
+                return result;
+            } catch (...) {
+                munmap(data, size);
+                throw;
+            }
+#else
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream) {
+                throw std::runtime_error(CALL_INFO + ": can not open: '" + path + "'");
+            }
+            std::vector<uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            return parse(data.data(), data.size());
+#endif
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void DescriptorCache::write(const std::string& path, const std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>>& value) {
+        try {
+            // little endian: magic, version, entry count,
+            // per entry: key count, (key length, key, value) per key, string count, (type, present, length, string) per string
+            std::vector<uint8_t> data(MAGIC, MAGIC + sizeof(MAGIC));
+            auto put = [&data](uint64_t number, size_t size) {
+                for (size_t i = 0; i < size; i++) {
+                    data.emplace_back((uint8_t) (number >> (8 * i)));
+                }
+            };
+            put(VERSION, 4);
+            put(value.size(), 4);
+            for (const auto& [device, strings] : value) {
+                put(device.size(), 1);
+                for (const auto& [key, number] : device) {
+                    if (key.size() > UINT8_MAX) {
+                        throw std::runtime_error(CALL_INFO + ": key is too long: '" + key + "'");
+                    }
+                    put(key.size(), 1);
+                    data.insert(data.end(), key.begin(), key.end());
+                    put(number, 2);
+                }
+                put(strings.size(), 1);
+                for (const auto& [type, string] : strings) {
+                    size_t size = string ? std::min(string.value().size(), (size_t) UINT16_MAX) : 0;
+                    put((uint64_t) type, 1);
+                    put(string ? 1 : 0, 1);
+                    put(size, 2);
+                    if (string) {
+                        data.insert(data.end(), string.value().begin(), string.value().begin() + (std::ptrdiff_t) size);
+                    }
+                }
+            }
+
+            // unique per process and call, concurrent writers each rename a complete file and the last one wins
+            static std::atomic<uint64_t> writeCount = 0;
+#if __has_include(<sys/mman.h>)
+            std::string temporaryPath = path + "." + std::to_string(getpid()) + "." + std::to_string(writeCount++) + ".tmp";
+            int file = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+            if (file < 0) {
+                throw std::runtime_error(CALL_INFO + ": can not open: '" + temporaryPath + "'");
+            }
+            size_t written = 0;
+            while (written < data.size()) {
+                ssize_t result = ::write(file, data.data() + written, data.size() - written);
+                if (result < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (result <= 0) {
+                    break;
+                }
+                written += (size_t) result;
+            }
+            // the data reaches the disk before the rename publishes it, a crash leaves the old or the new file
+            bool synced = written == data.size() && ::fsync(file) == 0;
+            ::close(file);
+            if (!synced) {
+                std::error_code removeError = {};
+                std::filesystem::remove(temporaryPath, removeError);
+                throw std::runtime_error(CALL_INFO + ": can not write: '" + temporaryPath + "'");
+            }
+#else
+            std::string temporaryPath = path + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "." + std::to_string(writeCount++) + ".tmp";
+            {
+                std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+                if (!stream) {
+                    throw std::runtime_error(CALL_INFO + ": can not open: '" + temporaryPath + "'");
+                }
+                stream.write((const char*) data.data(), (std::streamsize) data.size());
+                stream.flush();
+                if (!stream) {
+                    stream.close();
+                    std::error_code removeError = {};
+                    std::filesystem::remove(temporaryPath, removeError);
+                    throw std::runtime_error(CALL_INFO + ": can not write: '" + temporaryPath + "'");
+                }
+            }
+#endif
+            std::error_code renameError = {};
+            std::filesystem::rename(temporaryPath, path, renameError);
+            if (renameError) {
+                std::error_code removeError = {};
+                std::filesystem::remove(temporaryPath, removeError);
+                throw std::runtime_error(CALL_INFO + ": can not rename: '" + temporaryPath + "' to: '" + path + "' " + renameError.message());
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> DescriptorCache::parse(const uint8_t* data, size_t size) {
+        try {
+            size_t offset = 0;
+            auto take = [data, size, &offset](size_t length) {
+                if (length > size - offset) {
+                    throw std::runtime_error(CALL_INFO + ": corrupted at offset: " + std::to_string(offset));
+                }
+                const uint8_t* result = data + offset;
+                offset += length;
+                return result;
+            };
+            auto get = [&take](size_t length) {
+                const uint8_t* bytes = take(length);
+                uint64_t result = 0;
+                for (size_t i = 0; i < length; i++) {
+                    result |= (uint64_t) bytes[i] << (8 * i);
+                }
+                return result;
+            };
+
+            if (std::memcmp(take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+                throw std::runtime_error(CALL_INFO + ": not a descriptor cache!");
+            }
+            uint64_t version = get(4);
+            if (version != VERSION) {
+                throw std::runtime_error(CALL_INFO + ": unsupported version: " + std::to_string(version));
+            }
+
+            std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> result = {};
+            uint64_t entryCount = get(4);
+            for (uint64_t i = 0; i < entryCount; i++) {
+                std::map<std::string, uint16_t> device = {};
+                uint64_t keyCount = get(1);
+                for (uint64_t j = 0; j < keyCount; j++) {
+                    size_t keySize = (size_t) get(1);
+                    const char* key = (const char*) take(keySize);
+                    device.insert({std::string(key, keySize), (uint16_t) get(2)});
+                }
+                std::map<StringDescriptor, std::optional<std::string>>& strings = result[device];
+                uint64_t stringCount = get(1);
+                for (uint64_t j = 0; j < stringCount; j++) {
+                    uint64_t type = get(1);
+                    if (type > (uint64_t) StringDescriptor::SERIAL_NUMBER) {
+                        throw std::runtime_error(CALL_INFO + ": unknown string descriptor: " + std::to_string(type));
+                    }
+                    bool present = get(1) != 0;
+                    size_t stringSize = (size_t) get(2);
+                    const char* string = (const char*) take(stringSize);
+                    strings.insert({(StringDescriptor) type, present ? std::optional<std::string>(std::string(string, stringSize)) : std::nullopt});
+                }
+            }
+            if (offset != size) {
+                throw std::runtime_error(CALL_INFO + ": trailing data at offset: " + std::to_string(offset));
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <optional>
+#include <map>
+
+#include "exqudens/usb/export.hpp"
+#include "exqudens/usb/StringDescriptor.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Compact binary file of string descriptors per device, lets a restarted service skip the control transfers.
+    * Devices are keyed by their full device map (bus, port, address, vendor, product),
+    * a re-enumerated or replaced device gets a new address and misses the cache.
+    */
+    class EXQUDENS_USB_EXPORT DescriptorCache {
+
+        public:
+
+            inline static const char MAGIC[8] = {'E', 'X', 'Q', 'U', 'S', 'B', 'D', 'C'};
+            inline static const uint32_t VERSION = 1;
+
+            /*!
+            * Memory-maps and parses the file at 'path'.
+            *
+            * @return Cached strings per device, empty if the file does not exist.
+            *
+            * @throws std::runtime_error If the file can not be read or is corrupted.
+            */
+            static std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> read(const std::string& path);
+
+            /*!
+            * Writes 'value' to a temporary file unique to the call, syncs it and renames it to 'path',
+            * readers never see a partial file and concurrent writers (threads or processes) do not share the temporary file.
+            *
+            * @throws std::runtime_error
+            */
+            static void write(const std::string& path, const std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>>& value);
+
+        private:
+
+            static std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> parse(const uint8_t* data, size_t size);
+
+    };
+
+}
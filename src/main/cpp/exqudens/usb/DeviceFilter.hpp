@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <optional>
+#include <vector>
+#include <set>
+
+namespace exqudens::usb {
+
+    /*!
+    * Declarative device filter for 'listDevices', empty fields match any device.
+    * Transports check bus and port path first, then the cached device descriptor and only then open the device for the serial.
+    */
+    struct DeviceFilter {
+        std::set<uint16_t> vendors = {};
+        std::set<uint16_t> products = {};
+        std::optional<uint16_t> bus = {};
+        std::vector<uint8_t> portPath = {}; //!< Prefix of the port numbers from the root hub, e.g. '{1, 4}' matches port 4 of the hub on root port 1 and everything behind it.
+        std::optional<uint8_t> deviceClass = {};
+        std::optional<std::string> serial = {};
+    };
+
+}
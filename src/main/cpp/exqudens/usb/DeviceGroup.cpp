@@ -0,0 +1,181 @@
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/DeviceGroup.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    DeviceGroup::DeviceGroup(
+        const std::vector<std::shared_ptr<IClient>>& clients,
+        size_t threadCount
+    ):
+        clients(clients)
+    {
+        try {
+            for (const std::shared_ptr<IClient>& client : this->clients) {
+                if (!client) {
+                    throw std::runtime_error(CALL_INFO + ": client is null!");
+                }
+            }
+            threads.reserve(threadCount);
+            for (size_t i = 0; i < threadCount; i++) {
+                threads.emplace_back(&DeviceGroup::run, this);
+            }
+        } catch (...) {
+            // the destructor does not run, workers started before the failure would terminate the process as joinable threads
+            stop();
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    // transfers block, so one worker per device besides the calling thread
+    DeviceGroup::DeviceGroup(const std::vector<std::shared_ptr<IClient>>& clients): DeviceGroup(clients, clients.empty() ? 0 : clients.size() - 1) {}
+
+    std::vector<std::shared_ptr<IClient>> DeviceGroup::getClients() {
+        try {
+            return clients;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t DeviceGroup::getSize() {
+        try {
+            return clients.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<DeviceGroup::Result> DeviceGroup::execute(const std::function<Result(size_t index, const std::shared_ptr<IClient>& client)>& function) {
+        try {
+            std::vector<Result> results(clients.size());
+            if (clients.empty()) {
+                return results;
+            }
+
+            std::lock_guard<std::mutex> runLock(runMutex);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                task = [this, &function, &results](size_t index) {
+                    try {
+                        results.at(index) = function(index, clients.at(index));
+                    } catch (...) {
+                        results.at(index).error = std::current_exception();
+                    }
+                };
+                next = 0;
+                done = 0;
+                generation++;
+            }
+            condition.notify_all();
+
+            work();
+
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCondition.wait(lock, [this]() { return done == clients.size(); });
+            task = {};
+            return results;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<DeviceGroup::Result> DeviceGroup::broadcastWrite(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout) {
+        try {
+            return execute([&value, endpoint, timeout](size_t, const std::shared_ptr<IClient>& client) {
+                Result result = {};
+                result.size = client->bulkWrite(value, endpoint, timeout);
+                return result;
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<DeviceGroup::Result> DeviceGroup::gatherRead(uint8_t endpoint, uint32_t timeout, int32_t size) {
+        try {
+            return execute([endpoint, timeout, size](size_t, const std::shared_ptr<IClient>& client) {
+                Result result = {};
+                result.data = client->bulkRead(endpoint, timeout, size);
+                result.size = result.data.size();
+                return result;
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<DeviceGroup::Result> DeviceGroup::transactAll(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout, int32_t size) {
+        try {
+            return execute([&value, endpoint, timeout, size](size_t, const std::shared_ptr<IClient>& client) {
+                Result result = {};
+                client->bulkWrite(value, endpoint, timeout);
+                result.data = client->bulkRead(endpoint, timeout, size);
+                result.size = result.data.size();
+                return result;
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    DeviceGroup::~DeviceGroup() noexcept {
+        stop();
+    }
+
+    void DeviceGroup::stop() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+        for (std::thread& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    void DeviceGroup::run() {
+        size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            condition.wait(lock, [this, &seen]() { return stopped || generation != seen; });
+            if (stopped) {
+                return;
+            }
+            seen = generation;
+            lock.unlock();
+            work();
+            lock.lock();
+        }
+    }
+
+    void DeviceGroup::work() {
+        while (true) {
+            size_t index = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (next >= clients.size()) {
+                    return;
+                }
+                index = next++;
+            }
+            // 'task' is not reset before every index is done
+            task(index);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done++;
+                if (done == clients.size()) {
+                    doneCondition.notify_all();
+                }
+            }
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Runs the same operation on many open clients concurrently on a fixed set of worker threads.
+    * Every device gets its own result, a failing device does not affect the others.
+    */
+    class EXQUDENS_USB_EXPORT DeviceGroup {
+
+        public:
+
+            struct Result {
+                size_t size = 0; //!< Bytes written or read.
+                std::vector<uint8_t> data = {}; //!< Read data.
+                std::exception_ptr error = nullptr;
+            };
+
+        private:
+
+            std::vector<std::shared_ptr<IClient>> clients = {};
+            std::vector<std::thread> threads = {};
+            std::mutex runMutex = {};
+            std::mutex mutex = {};
+            std::condition_variable condition = {};
+            std::condition_variable doneCondition = {};
+            std::function<void(size_t index)> task = {};
+            size_t next = 0;
+            size_t done = 0;
+            size_t generation = 0;
+            bool stopped = false;
+
+        public:
+
+            DeviceGroup(
+                const std::vector<std::shared_ptr<IClient>>& clients,
+                size_t threadCount //!< Worker threads besides the calling thread.
+            );
+            explicit DeviceGroup(const std::vector<std::shared_ptr<IClient>>& clients);
+            DeviceGroup(const DeviceGroup& other) = delete;
+
+            DeviceGroup& operator=(const DeviceGroup& other) = delete;
+
+            std::vector<std::shared_ptr<IClient>> getClients();
+
+            size_t getSize();
+
+            /*!
+            * Runs 'function' for every client concurrently and waits for all of them.
+            *
+            * @return Results in client order, exceptions of 'function' are stored in 'Result::error'.
+            */
+            std::vector<Result> execute(const std::function<Result(size_t index, const std::shared_ptr<IClient>& client)>& function);
+
+            /*!
+            * Writes 'value' to every device.
+            */
+            std::vector<Result> broadcastWrite(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout);
+
+            /*!
+            * Reads up to 'size' bytes from every device.
+            */
+            std::vector<Result> gatherRead(uint8_t endpoint, uint32_t timeout, int32_t size);
+
+            /*!
+            * Writes 'value' to every device and reads up to 'size' bytes of its response.
+            */
+            std::vector<Result> transactAll(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout, int32_t size);
+
+            ~DeviceGroup() noexcept;
+
+        private:
+
+            /*!
+            * Stops and joins the workers.
+            */
+            void stop() noexcept;
+
+            void run();
+
+            void work();
+
+    };
+
+}
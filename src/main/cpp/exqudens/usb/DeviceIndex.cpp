@@ -0,0 +1,302 @@
+#include <algorithm>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/DeviceIndex.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    DeviceIndex::DeviceIndex(
+        const std::function<std::shared_ptr<IClient>()>& clientFunction,
+        const Options& options
+    ):
+        clientFunction(clientFunction),
+        options(options)
+    {
+        try {
+            if (!clientFunction) {
+                throw std::runtime_error(CALL_INFO + ": client function is empty!");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    DeviceIndex::DeviceIndex(const std::function<std::shared_ptr<IClient>()>& clientFunction): DeviceIndex(clientFunction, Options {}) {}
+
+    DeviceIndex::Options DeviceIndex::getOptions() {
+        try {
+            return options;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t DeviceIndex::refresh() {
+        try {
+            // one enumeration at a time, lookups keep using the previous index meanwhile
+            std::lock_guard<std::mutex> refreshLock(refreshMutex);
+            if (!client) {
+                client = clientFunction();
+            }
+
+            std::unordered_map<std::string, std::map<std::string, uint16_t>> newBySerial = {};
+            std::unordered_map<std::string, std::map<std::string, uint16_t>> newByPortPath = {};
+            std::unordered_map<uint32_t, std::vector<std::map<std::string, uint16_t>>> newByVendorProduct = {};
+            std::vector<std::map<std::string, uint16_t>> devices = client->listDevices();
+            std::optional<std::vector<std::map<std::string, uint16_t>>> listed = {};
+            size_t newSize = 0;
+            for (const std::map<std::string, uint16_t>& device : devices) {
+                if (options.readSerials) {
+                    // cached by the client, only devices new since the last refresh cost control transfers
+                    std::optional<std::string> serial = {};
+                    try {
+                        serial = client->getStringDescriptor(device, StringDescriptor::SERIAL_NUMBER);
+                    } catch (...) {
+                        // detached after the enumeration, otherwise (e.g. no permission) indexed without the serial
+                        if (!listed) {
+                            listed = client->listDevices();
+                        }
+                        if (std::ranges::find(listed.value(), device) == listed.value().end()) {
+                            continue;
+                        }
+                    }
+                    if (serial && !serial.value().empty()) {
+                        newBySerial.try_emplace(serial.value(), device);
+                    }
+                }
+                newByPortPath.try_emplace(toPortPathName(device), device);
+                newByVendorProduct[toVendorProduct(device.at("vendor"), device.at("product"))].emplace_back(device);
+                newSize++;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            bySerial = std::move(newBySerial);
+            byPortPath = std::move(newByPortPath);
+            byVendorProduct = std::move(newByVendorProduct);
+            size = newSize;
+            refreshCount++;
+            return size;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t DeviceIndex::getSize() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return size;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t DeviceIndex::getRefreshCount() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return refreshCount;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> DeviceIndex::findBySerial(const std::string& serial) {
+        try {
+            return find([this, &serial]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto entry = bySerial.find(serial);
+                return entry == bySerial.end() ? std::map<std::string, uint16_t> {} : entry->second;
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> DeviceIndex::findByPortPath(uint16_t bus, const std::vector<uint8_t>& portPath) {
+        try {
+            return findByPortPath(toPortPathName(bus, portPath));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> DeviceIndex::findByPortPath(const std::string& name) {
+        try {
+            return find([this, &name]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto entry = byPortPath.find(name);
+                return entry == byPortPath.end() ? std::map<std::string, uint16_t> {} : entry->second;
+            });
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> DeviceIndex::findByVendorProduct(uint16_t vendor, uint16_t product) {
+        try {
+            auto lookup = [this, vendor, product]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto entry = byVendorProduct.find(toVendorProduct(vendor, product));
+                return entry == byVendorProduct.end() ? std::vector<std::map<std::string, uint16_t>> {} : entry->second;
+            };
+            std::vector<std::map<std::string, uint16_t>> result = lookup();
+            if (result.empty() && options.refreshOnMiss) {
+                refresh();
+                result = lookup();
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> DeviceIndex::openBySerial(
+        const std::string& serial,
+        const std::optional<int32_t>& interfaceNumber,
+        const std::optional<bool>& detachKernelDriver
+    ) {
+        try {
+            return open(
+                [this, &serial]() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto entry = bySerial.find(serial);
+                    return entry == bySerial.end() ? std::map<std::string, uint16_t> {} : entry->second;
+                },
+                "serial: '" + serial + "'",
+                interfaceNumber,
+                detachKernelDriver
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> DeviceIndex::openBySerial(const std::string& serial) {
+        try {
+            return openBySerial(serial, {}, {});
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> DeviceIndex::openByPortPath(
+        const std::string& name,
+        const std::optional<int32_t>& interfaceNumber,
+        const std::optional<bool>& detachKernelDriver
+    ) {
+        try {
+            return open(
+                [this, &name]() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto entry = byPortPath.find(name);
+                    return entry == byPortPath.end() ? std::map<std::string, uint16_t> {} : entry->second;
+                },
+                "port path: '" + name + "'",
+                interfaceNumber,
+                detachKernelDriver
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> DeviceIndex::openByPortPath(const std::string& name) {
+        try {
+            return openByPortPath(name, {}, {});
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<uint8_t> DeviceIndex::toPortPath(const std::map<std::string, uint16_t>& device) {
+        try {
+            std::vector<uint8_t> result = {};
+            for (size_t i = 0; device.contains("portPath" + std::to_string(i)); i++) {
+                result.emplace_back((uint8_t) device.at("portPath" + std::to_string(i)));
+            }
+            if (result.empty() && device.contains("port") && device.at("port") != 0) {
+                result.emplace_back((uint8_t) device.at("port"));
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string DeviceIndex::toPortPathName(const std::map<std::string, uint16_t>& device) {
+        try {
+            return toPortPathName(device.contains("bus") ? device.at("bus") : 0, toPortPath(device));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string DeviceIndex::toPortPathName(uint16_t bus, const std::vector<uint8_t>& portPath) {
+        try {
+            std::ostringstream out;
+            out << bus << "-";
+            for (size_t i = 0; i < portPath.size(); i++) {
+                out << (i == 0 ? "" : ".") << (int) portPath.at(i);
+            }
+            return out.str();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> DeviceIndex::find(const std::function<std::map<std::string, uint16_t>()>& function) {
+        try {
+            std::map<std::string, uint16_t> result = function();
+            if (result.empty() && options.refreshOnMiss) {
+                refresh();
+                result = function();
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::shared_ptr<IClient> DeviceIndex::open(
+        const std::function<std::map<std::string, uint16_t>()>& function,
+        const std::string& name,
+        const std::optional<int32_t>& interfaceNumber,
+        const std::optional<bool>& detachKernelDriver
+    ) {
+        try {
+            std::map<std::string, uint16_t> device = find(function);
+            if (device.empty()) {
+                throw std::runtime_error(CALL_INFO + ": device is not attached: " + name);
+            }
+            std::shared_ptr<IClient> result = clientFunction();
+            try {
+                result->open(device, interfaceNumber, detachKernelDriver);
+            } catch (...) {
+                // the entry may be stale (re-enumerated with a new address), look it up once more
+                refresh();
+                std::map<std::string, uint16_t> current = function();
+                if (current.empty() || current == device) {
+                    throw;
+                }
+                result->open(current, interfaceNumber, detachKernelDriver);
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint32_t DeviceIndex::toVendorProduct(uint16_t vendor, uint16_t product) {
+        try {
+            return ((uint32_t) vendor << 16) | product;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
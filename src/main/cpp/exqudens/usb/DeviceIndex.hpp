@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <mutex>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Hash index of the attached devices by serial, by port path and by vendor/product,
+    * built by one enumeration with the serials read once and cached by the client.
+    * Lookups do not enumerate, a miss re-enumerates once if 'Options::refreshOnMiss' is set.
+    */
+    class EXQUDENS_USB_EXPORT DeviceIndex {
+
+        public:
+
+            struct Options {
+                bool refreshOnMiss = true; //!< Re-enumerate once when a lookup misses, e.g. after a device was plugged in.
+                bool readSerials = true; //!< Index by serial, reading it costs control transfers on first enumeration of a device.
+            };
+
+        private:
+
+            std::function<std::shared_ptr<IClient>()> clientFunction = {};
+            Options options = {};
+            std::shared_ptr<IClient> client = nullptr;
+            std::mutex refreshMutex = {};
+            std::mutex mutex = {};
+            std::unordered_map<std::string, std::map<std::string, uint16_t>> bySerial = {};
+            std::unordered_map<std::string, std::map<std::string, uint16_t>> byPortPath = {};
+            std::unordered_map<uint32_t, std::vector<std::map<std::string, uint16_t>>> byVendorProduct = {};
+            size_t size = 0;
+            size_t refreshCount = 0;
+
+        public:
+
+            DeviceIndex(
+                const std::function<std::shared_ptr<IClient>()>& clientFunction, //!< Creates initialized, not open clients, the first one enumerates.
+                const Options& options
+            );
+            explicit DeviceIndex(const std::function<std::shared_ptr<IClient>()>& clientFunction);
+            DeviceIndex(const DeviceIndex& other) = delete;
+
+            DeviceIndex& operator=(const DeviceIndex& other) = delete;
+
+            Options getOptions();
+
+            /*!
+            * Re-enumerates the devices and replaces the index, a device detached before its serial was read is skipped,
+            * one whose serial can not be read (e.g. no permission) is indexed by port path and vendor/product only.
+            *
+            * @return A number of indexed devices.
+            *
+            * @throws std::runtime_error
+            */
+            size_t refresh();
+
+            size_t getSize();
+
+            size_t getRefreshCount();
+
+            /*!
+            * @return The device or an empty map if no attached device has the serial.
+            */
+            std::map<std::string, uint16_t> findBySerial(const std::string& serial);
+
+            /*!
+            * @return The device on 'portPath' of 'bus' or an empty map.
+            */
+            std::map<std::string, uint16_t> findByPortPath(uint16_t bus, const std::vector<uint8_t>& portPath);
+
+            /*!
+            * @return The device with the port path name 'name', e.g. '1-1.4.2', or an empty map.
+            */
+            std::map<std::string, uint16_t> findByPortPath(const std::string& name);
+
+            std::vector<std::map<std::string, uint16_t>> findByVendorProduct(uint16_t vendor, uint16_t product);
+
+            /*!
+            * Creates a client and opens the device with the serial.
+            * A stale entry (device re-enumerated since the last refresh) is refreshed and opened once more.
+            *
+            * @throws std::runtime_error If no attached device has the serial or it can not be opened.
+            */
+            std::shared_ptr<IClient> openBySerial(
+                const std::string& serial,
+                const std::optional<int32_t>& interfaceNumber,
+                const std::optional<bool>& detachKernelDriver
+            );
+
+            std::shared_ptr<IClient> openBySerial(const std::string& serial);
+
+            /*!
+            * Creates a client and opens the device with the port path name 'name', e.g. '1-1.4.2'.
+            *
+            * @throws std::runtime_error If no device is attached there or it can not be opened.
+            */
+            std::shared_ptr<IClient> openByPortPath(
+                const std::string& name,
+                const std::optional<int32_t>& interfaceNumber,
+                const std::optional<bool>& detachKernelDriver
+            );
+
+            std::shared_ptr<IClient> openByPortPath(const std::string& name);
+
+            /*!
+            * @return The port numbers from the root hub, the single 'port' if the transport does not report the path.
+            */
+            static std::vector<uint8_t> toPortPath(const std::map<std::string, uint16_t>& device);
+
+            /*!
+            * @return The sysfs style name '<bus>-<port>.<port>...' of the device, e.g. '1-1.4.2'.
+            */
+            static std::string toPortPathName(const std::map<std::string, uint16_t>& device);
+
+            static std::string toPortPathName(uint16_t bus, const std::vector<uint8_t>& portPath);
+
+        private:
+
+            std::map<std::string, uint16_t> find(const std::function<std::map<std::string, uint16_t>()>& function);
+
+            std::shared_ptr<IClient> open(
+                const std::function<std::map<std::string, uint16_t>()>& function,
+                const std::string& name,
+                const std::optional<int32_t>& interfaceNumber,
+                const std::optional<bool>& detachKernelDriver
+            );
+
+            static uint32_t toVendorProduct(uint16_t vendor, uint16_t product);
+
+    };
+
+}
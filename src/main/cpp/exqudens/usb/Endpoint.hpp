@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace exqudens::usb {
+
+    struct In {
+        inline static constexpr uint8_t MASK = 0x80; //!< 'LIBUSB_ENDPOINT_IN'.
+    };
+
+    struct Out {
+        inline static constexpr uint8_t MASK = 0x00; //!< 'LIBUSB_ENDPOINT_OUT'.
+    };
+
+    struct Bulk {
+        inline static constexpr uint8_t VALUE = 0x02; //!< 'LIBUSB_ENDPOINT_TRANSFER_TYPE_BULK'.
+    };
+
+    struct Interrupt {
+        inline static constexpr uint8_t VALUE = 0x03; //!< 'LIBUSB_ENDPOINT_TRANSFER_TYPE_INTERRUPT'.
+    };
+
+    /*!
+    * Endpoint known at compile time, e.g. 'Endpoint<1, In, Bulk>' is the bulk IN endpoint '0x81'.
+    * The typed transfer functions of 'IClient' only accept endpoints of matching direction and type,
+    * so e.g. a read from an OUT endpoint does not compile.
+    */
+    template<uint8_t NUMBER, typename DIRECTION, typename TYPE>
+    struct Endpoint {
+
+        static_assert(NUMBER >= 1 && NUMBER <= 15, "endpoint number must be in range [1, 15], '0' is the control endpoint");
+        static_assert(std::is_same_v<DIRECTION, In> || std::is_same_v<DIRECTION, Out>, "direction must be 'In' or 'Out'");
+        static_assert(std::is_same_v<TYPE, Bulk> || std::is_same_v<TYPE, Interrupt>, "type must be 'Bulk' or 'Interrupt'");
+
+        using Direction = DIRECTION;
+        using Type = TYPE;
+
+        inline static constexpr uint8_t ADDRESS = NUMBER | DIRECTION::MASK;
+
+    };
+
+    template<typename ENDPOINT>
+    concept BulkInEndpoint = std::is_same_v<typename ENDPOINT::Direction, In> && std::is_same_v<typename ENDPOINT::Type, Bulk>;
+
+    template<typename ENDPOINT>
+    concept BulkOutEndpoint = std::is_same_v<typename ENDPOINT::Direction, Out> && std::is_same_v<typename ENDPOINT::Type, Bulk>;
+
+}
@@ -0,0 +1,233 @@
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "exqudens/usb/Framer.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    namespace {
+
+        size_t findScalar(const uint8_t* data, size_t size, uint8_t value) {
+            for (size_t i = 0; i < size; i++) {
+                if (data[i] == value) {
+                    return i;
+                }
+            }
+            return size;
+        }
+
+#if defined(__x86_64__) || defined(_M_X64)
+        // SSE2 is part of x86-64, no runtime check needed
+        size_t findSse2(const uint8_t* data, size_t size, uint8_t value) {
+            const __m128i pattern = _mm_set1_epi8((char) value);
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                __m128i block = _mm_loadu_si128((const __m128i*) (data + i));
+                int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+                if (mask != 0) {
+                    return i + (size_t) std::countr_zero((unsigned int) mask);
+                }
+            }
+            return i + findScalar(data + i, size - i, value);
+        }
+
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((target("avx2")))
+        size_t findAvx2(const uint8_t* data, size_t size, uint8_t value) {
+            const __m256i pattern = _mm256_set1_epi8((char) value);
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32) {
+                __m256i block = _mm256_loadu_si256((const __m256i*) (data + i));
+                unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+                if (mask != 0) {
+                    return i + (size_t) std::countr_zero(mask);
+                }
+            }
+            return i + findSse2(data + i, size - i, value);
+        }
+#endif
+#endif
+
+    }
+
+    Framer::Framer(
+        const std::shared_ptr<IClient>& client,
+        uint8_t endpoint,
+        uint32_t timeout,
+        const Options& options
+    ):
+        client(client),
+        endpoint(endpoint),
+        timeout(timeout),
+        options(options)
+    {
+        try {
+            if (options.lengthSize == 0 && options.delimiter.empty()) {
+                throw std::runtime_error(CALL_INFO + ": delimiter is empty!");
+            }
+            if (options.lengthSize != 0 && options.lengthSize != 1 && options.lengthSize != 2 && options.lengthSize != 4) {
+                throw std::runtime_error(CALL_INFO + ": lengthSize must be '0', '1', '2' or '4'!");
+            }
+            if (options.readSize == 0) {
+                throw std::runtime_error(CALL_INFO + ": readSize must be greater zero!");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Framer::Framer(const Options& options): Framer(nullptr, 0, 0, options) {}
+
+    void Framer::push(const uint8_t* value, size_t size) {
+        try {
+            std::memcpy(prepare(size), value, size);
+            end += size;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Framer::read() {
+        try {
+            if (!client) {
+                throw std::runtime_error(CALL_INFO + ": client is null! use 'push'...");
+            }
+            // a non-owning buffer over the free tail, the transfer writes straight into it
+            Buffer buffer(prepare(options.readSize), options.readSize, false, {});
+            size_t size = client->bulkRead(buffer, endpoint, timeout, false);
+            end += size;
+            return size;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::span<const uint8_t>> Framer::next() {
+        try {
+            return options.lengthSize > 0 ? nextLengthPrefixed() : nextDelimited();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::span<const uint8_t> Framer::receive() {
+        try {
+            std::optional<std::span<const uint8_t>> result = next();
+            while (!result) {
+                read();
+                result = next();
+            }
+            return result.value();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Framer::getPendingSize() {
+        try {
+            return end - begin;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t Framer::find(const uint8_t* data, size_t size, uint8_t value) {
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(__GNUC__) || defined(__clang__)
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        if (avx2) {
+            return findAvx2(data, size, value);
+        }
+#endif
+        return findSse2(data, size, value);
+#else
+        return findScalar(data, size, value);
+#endif
+    }
+
+    uint8_t* Framer::prepare(size_t size) {
+        try {
+            // moving the unconsumed bytes to the front invalidates the returned views
+            if (begin > 0) {
+                std::memmove(data.data(), data.data() + begin, end - begin);
+                scanned -= begin;
+                end -= begin;
+                begin = 0;
+            }
+            if (data.size() < end + size) {
+                data.resize(std::max(end + size, data.size() * 2));
+            }
+            return data.data() + end;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::span<const uint8_t>> Framer::nextDelimited() {
+        try {
+            const std::vector<uint8_t>& delimiter = options.delimiter;
+            size_t position = std::max(scanned, begin);
+            while (position < end) {
+                position += find(data.data() + position, end - position, delimiter.front());
+                if (position == end) {
+                    break;
+                }
+                if (end - position < delimiter.size()) {
+                    // a delimiter may continue in the next read
+                    scanned = position;
+                    return {};
+                }
+                if (std::equal(delimiter.begin() + 1, delimiter.end(), data.data() + position + 1)) {
+                    std::span<const uint8_t> result(data.data() + begin, position - begin);
+                    begin = position + delimiter.size();
+                    scanned = begin;
+                    return result;
+                }
+                position++;
+            }
+            scanned = end;
+            if (end - begin > options.maxMessageSize) {
+                throw std::runtime_error(CALL_INFO + ": no delimiter within maxMessageSize: " + std::to_string(options.maxMessageSize));
+            }
+            return {};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::span<const uint8_t>> Framer::nextLengthPrefixed() {
+        try {
+            if (end - begin < options.lengthSize) {
+                return {};
+            }
+            size_t size = 0;
+            for (size_t i = 0; i < options.lengthSize; i++) {
+                size_t shift = options.bigEndian ? 8 * (options.lengthSize - 1 - i) : 8 * i;
+                size |= (size_t) data.at(begin + i) << shift;
+            }
+            if (size > options.maxMessageSize) {
+                throw std::runtime_error(CALL_INFO + ": message size: " + std::to_string(size) + " exceeds maxMessageSize: " + std::to_string(options.maxMessageSize));
+            }
+            if (end - begin - options.lengthSize < size) {
+                return {};
+            }
+            std::span<const uint8_t> result(data.data() + begin + options.lengthSize, size);
+            begin += options.lengthSize + size;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
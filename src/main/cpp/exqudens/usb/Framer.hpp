@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Splits a bulk IN byte stream into messages, either delimiter terminated or length prefixed.
+    * Messages may be split across or packed into reads. Delimiters are searched with SSE2 / AVX2 (selected at runtime)
+    * on x86-64 and byte by byte elsewhere.
+    * Returned messages are views into the receive buffer, valid until the next 'push', 'read' or 'receive'.
+    */
+    class EXQUDENS_USB_EXPORT Framer {
+
+        public:
+
+            struct Options {
+                std::vector<uint8_t> delimiter = {'\n'}; //!< Message terminator, not part of the message. Ignored if 'lengthSize' is set.
+                size_t lengthSize = 0; //!< '1', '2' or '4' byte length prefix (not counted in the length) instead of a delimiter.
+                bool bigEndian = false; //!< Byte order of the length prefix.
+                size_t maxMessageSize = 1 << 20; //!< Larger messages or unterminated data throw, the stream is out of sync.
+                size_t readSize = 16 * 512; //!< Bytes per bulk read.
+            };
+
+        private:
+
+            std::shared_ptr<IClient> client = nullptr;
+            uint8_t endpoint = 0;
+            uint32_t timeout = 0;
+            Options options = {};
+            std::vector<uint8_t> data = {};
+            size_t begin = 0; //!< First byte of the next message.
+            size_t end = 0; //!< End of the received bytes.
+            size_t scanned = 0; //!< Delimiter search resumes here.
+
+        public:
+
+            Framer(
+                const std::shared_ptr<IClient>& client,
+                uint8_t endpoint, //!< IN endpoint address, e.g. '0x81'.
+                uint32_t timeout, //!< Per transfer, '0' for unlimited.
+                const Options& options
+            );
+            explicit Framer(const Options& options); //!< Without a client, data is passed to 'push'.
+            Framer(const Framer& other) = delete;
+
+            Framer& operator=(const Framer& other) = delete;
+
+            /*!
+            * Appends received bytes.
+            */
+            void push(const uint8_t* value, size_t size);
+
+            /*!
+            * Performs one bulk read directly into the receive buffer.
+            *
+            * @return A number of bytes read.
+            *
+            * @throws std::runtime_error
+            */
+            size_t read();
+
+            /*!
+            * @return The next complete message or empty if more data is needed.
+            *
+            * @throws std::runtime_error If a message exceeds 'Options::maxMessageSize'.
+            */
+            std::optional<std::span<const uint8_t>> next();
+
+            /*!
+            * Reads until a complete message is available.
+            *
+            * @throws std::runtime_error
+            */
+            std::span<const uint8_t> receive();
+
+            /*!
+            * @return A number of received bytes that are not part of a returned message yet.
+            */
+            size_t getPendingSize();
+
+            /*!
+            * @return Position of the first 'value' in 'data' or 'size' if not found.
+            */
+            static size_t find(const uint8_t* data, size_t size, uint8_t value);
+
+        private:
+
+            uint8_t* prepare(size_t size);
+
+            std::optional<std::span<const uint8_t>> nextDelimited();
+
+            std::optional<std::span<const uint8_t>> nextLengthPrefixed();
+
+    };
+
+}
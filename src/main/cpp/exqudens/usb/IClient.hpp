@@ -7,8 +7,16 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include <memory>
+#include <chrono>
 
 #include "exqudens/usb/export.hpp"
+#include "exqudens/usb/Buffer.hpp"
+#include "exqudens/usb/CancellationToken.hpp"
+#include "exqudens/usb/DeviceFilter.hpp"
+#include "exqudens/usb/StringDescriptor.hpp"
+#include "exqudens/usb/Endpoint.hpp"
+#include "exqudens/usb/TransferInfo.hpp"
 
 namespace exqudens::usb {
 
@@ -40,12 +48,52 @@ namespace exqudens::usb {
             /*!
             * Lists USB devices.
             *
-            * @return An available USB devices, each represented by a map with keys: ["vendor", "product", "port", "bus", "address"].
+            * @return An available USB devices, each represented by a map with keys: ["vendor", "product", "port", "bus", "address"]
+            * and the port numbers from the root hub as "portPath0", "portPath1", ... where the transport knows them.
             *
             * @throws std::runtime_error
             */
             virtual std::vector<std::map<std::string, uint16_t>> listDevices() = 0;
 
+            /*!
+            * Lists USB devices matching the filter.
+            * Bus and port path are checked first, then vendor, product and class from the cached device descriptor,
+            * the serial is read only from devices passing every other check.
+            *
+            * @throws std::runtime_error
+            */
+            virtual std::vector<std::map<std::string, uint16_t>> listDevices(const DeviceFilter& filter) = 0;
+
+            /*!
+            * Reads a string descriptor (manufacturer, product, serial number) of 'device' on first access
+            * and caches it per attached device, a re-enumerated device gets a new address and is read again.
+            *
+            * @return The string or empty if the device does not have it or can not be opened.
+            *
+            * @throws std::runtime_error
+            */
+            virtual std::optional<std::string> getStringDescriptor(
+                const std::map<std::string, uint16_t>& device,
+                StringDescriptor type
+            ) = 0;
+
+            /*!
+            * Loads string descriptors saved by 'saveDescriptorCache', entries of devices that are not attached are skipped.
+            * Verification only enumerates the devices, no control transfers.
+            *
+            * @return A number of loaded devices, '0' if the file does not exist.
+            *
+            * @throws std::runtime_error If the file is corrupted.
+            */
+            virtual size_t loadDescriptorCache(const std::string& path) = 0;
+
+            /*!
+            * Saves the cached string descriptors to 'path'.
+            *
+            * @throws std::runtime_error
+            */
+            virtual void saveDescriptorCache(const std::string& path) = 0;
+
             virtual std::string toString(
                 const std::map<std::string, uint16_t>& value
             ) = 0;
@@ -64,6 +112,66 @@ namespace exqudens::usb {
 
             virtual std::map<std::string, uint16_t> getDevice() = 0;
 
+            /*!
+            * Enables transparent reconnect, empty 'timeout' disables it.
+            * A transfer failing with 'LIBUSB_ERROR_NO_DEVICE' waits up to 'timeout' milliseconds for the same device
+            * (vendor, product, bus, port path) to re-enumerate, reopens it with the same interface and kernel driver settings and is retried once.
+            * If the device is not back in time the transfer throws and 'isReconnecting' stays 'true' until a later call reconnects.
+            * Transfers with a deadline wait and retry only until the deadline and stop waiting once their token is cancelled.
+            */
+            virtual void setReconnect(const std::optional<uint32_t>& timeout) = 0;
+
+            virtual bool isReconnecting() = 0;
+
+            /*!
+            * Waits up to 'timeout' milliseconds for the lost device and reopens it.
+            *
+            * @return 'true' if the device is open.
+            *
+            * @throws std::runtime_error
+            */
+            virtual bool reconnect(uint32_t timeout) = 0;
+
+            /*!
+            * Records the submit and completion time (steady clock) and a sequence number of every transfer,
+            * the last 'capacity' transfers per endpoint are kept. '0' (the default) disables the recording.
+            */
+            virtual void setTimelineCapacity(size_t capacity) = 0;
+
+            /*!
+            * @return The kept transfers in submit order, 'TransferTimeline::toChromeTrace' exports them.
+            */
+            virtual std::vector<TransferInfo> getTimeline() = 0;
+
+            /*!
+            * @return The last transfer of the calling thread on this client, empty while the recording is disabled.
+            */
+            virtual std::optional<TransferInfo> getLastTransfer() = 0;
+
+            /*!
+            * Applies the thread options of a libusb client ('ClientFactory::createShared' with 'ThreadOptions')
+            * to the calling thread, other transports have none and nothing is done.
+            *
+            * @return The options that could not be applied.
+            *
+            * @throws std::runtime_error If an option can not be applied and 'ThreadOptions::strict' is set.
+            */
+            virtual std::vector<std::string> tuneCurrentThread() = 0;
+
+            /*!
+            * @return The options the last 'tuneCurrentThread' call could not apply.
+            */
+            virtual std::vector<std::string> getThreadErrors() = 0;
+
+            /*!
+            * Leases a reusable transfer buffer from the open device.
+            * Device memory ('libusb_dev_mem_alloc') is used when available, otherwise heap memory.
+            * Buffers must be released before 'destroy'.
+            *
+            * @throws std::runtime_error
+            */
+            virtual Buffer allocateBuffer(size_t capacity) = 0;
+
             virtual uint8_t toWriteEndpoint(uint8_t endpoint) = 0;
             virtual uint8_t toReadEndpoint(uint8_t endpoint) = 0;
 
@@ -71,11 +179,59 @@ namespace exqudens::usb {
             virtual size_t bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint, uint32_t timeout) = 0;
             virtual size_t bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint) = 0;
 
+            /*!
+            * Writes 'value.getSize()' bytes from the buffer.
+            */
+            virtual size_t bulkWrite(const Buffer& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) = 0;
+            virtual size_t bulkWrite(const Buffer& value, uint8_t endpoint, uint32_t timeout) = 0;
+
+            /*!
+            * Deadline variants, the transfer may take the time left until 'deadline'.
+            * The in-flight transfer is cancelled through 'token' (may be null).
+            *
+            * @throws std::runtime_error with 'LIBUSB_ERROR_TIMEOUT' once the deadline passed or 'LIBUSB_ERROR_INTERRUPTED' when cancelled.
+            */
+            virtual size_t bulkWrite(const std::vector<uint8_t>& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) = 0;
+            virtual size_t bulkWrite(const Buffer& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) = 0;
+
             virtual std::vector<uint8_t> bulkRead(uint8_t endpoint, uint32_t timeout, int32_t size, bool autoEndpointDirection) = 0;
             virtual std::vector<uint8_t> bulkRead(uint8_t endpoint, uint32_t timeout, int32_t size) = 0;
             virtual std::vector<uint8_t> bulkRead(uint8_t endpoint, uint32_t timeout) = 0;
             virtual std::vector<uint8_t> bulkRead(uint8_t endpoint) = 0;
 
+            /*!
+            * Reads up to 'value.getCapacity()' bytes into the buffer and updates 'value.getSize()'.
+            * A failed transfer throws a nested 'TransferError' with the bytes already in the buffer.
+            */
+            virtual size_t bulkRead(Buffer& value, uint8_t endpoint, uint32_t timeout, bool autoEndpointDirection) = 0;
+            virtual size_t bulkRead(Buffer& value, uint8_t endpoint, uint32_t timeout) = 0;
+
+            virtual std::vector<uint8_t> bulkRead(uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, int32_t size, const std::shared_ptr<CancellationToken>& token) = 0;
+            virtual size_t bulkRead(Buffer& value, uint8_t endpoint, const std::chrono::steady_clock::time_point& deadline, const std::shared_ptr<CancellationToken>& token) = 0;
+
+            /*!
+            * Typed variants, the endpoint address is a compile time constant and no direction is applied at runtime.
+            */
+            template<BulkOutEndpoint ENDPOINT>
+            size_t bulkWrite(const std::vector<uint8_t>& value, uint32_t timeout) {
+                return bulkWrite(value, ENDPOINT::ADDRESS, timeout, false);
+            }
+
+            template<BulkOutEndpoint ENDPOINT>
+            size_t bulkWrite(const Buffer& value, uint32_t timeout) {
+                return bulkWrite(value, ENDPOINT::ADDRESS, timeout, false);
+            }
+
+            template<BulkInEndpoint ENDPOINT>
+            std::vector<uint8_t> bulkRead(uint32_t timeout, int32_t size) {
+                return bulkRead(ENDPOINT::ADDRESS, timeout, size, false);
+            }
+
+            template<BulkInEndpoint ENDPOINT>
+            size_t bulkRead(Buffer& value, uint32_t timeout) {
+                return bulkRead(value, ENDPOINT::ADDRESS, timeout, false);
+            }
+
             virtual void close() = 0;
 
             virtual void destroy() = 0;
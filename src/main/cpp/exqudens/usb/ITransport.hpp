@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <optional>
+#include <memory>
+#include <vector>
+#include <map>
+
+#include "exqudens/usb/export.hpp"
+#include "exqudens/usb/Buffer.hpp"
+#include "exqudens/usb/CancellationToken.hpp"
+#include "exqudens/usb/DeviceFilter.hpp"
+#include "exqudens/usb/StringDescriptor.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Low level device access used by 'Client'.
+    * Transfer functions return libusb error codes ('0' on success) so the caller decides how to report them.
+    */
+    class EXQUDENS_USB_EXPORT ITransport {
+
+        public:
+
+            struct PollStats {
+                uint64_t spinHits = 0; //!< Transfers completed within the spin budget.
+                uint64_t spinMisses = 0; //!< Transfers that fell back to the blocking wait.
+            };
+
+            virtual std::string getName() = 0;
+
+            virtual void init() = 0;
+
+            virtual bool isInitialized() = 0;
+
+            /*!
+            * Lists USB devices.
+            *
+            * @return An available USB devices, each represented by a map with keys: ["vendor", "product", "port", "bus", "address"].
+            *
+            * @throws std::runtime_error
+            */
+            virtual std::vector<std::map<std::string, uint16_t>> listDevices() = 0;
+
+            /*!
+            * Lists USB devices matching the filter, non-matching devices are skipped with the cheapest check.
+            *
+            * @throws std::runtime_error
+            */
+            virtual std::vector<std::map<std::string, uint16_t>> listDevices(const DeviceFilter& filter) = 0;
+
+            /*!
+            * Matches a device map against a listed one by "vendor", "product", "bus", "port" and "address".
+            * The "portPath<i>" keys are compared only where both maps have them,
+            * so maps built by hand or by versions without them (e.g. descriptor cache files) still match.
+            */
+            static bool matches(const std::map<std::string, uint16_t>& value, const std::map<std::string, uint16_t>& entry) {
+                for (const char* key : {"vendor", "product", "bus", "port", "address"}) {
+                    if (!value.contains(key) || !entry.contains(key) || value.at(key) != entry.at(key)) {
+                        return false;
+                    }
+                }
+                for (size_t i = 0; value.contains("portPath" + std::to_string(i)) && entry.contains("portPath" + std::to_string(i)); i++) {
+                    if (value.at("portPath" + std::to_string(i)) != entry.at("portPath" + std::to_string(i))) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /*!
+            * Reads a string descriptor of 'device', the device is opened for the read unless it is the open one.
+            * Every call costs control transfers, 'Client' caches the result.
+            *
+            * @return The string or empty if the device does not have it or can not be opened.
+            *
+            * @throws std::runtime_error If 'device' is not attached.
+            */
+            virtual std::optional<std::string> getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) = 0;
+
+            /*!
+            * Opens the device and claims the interface.
+            *
+            * @throws std::runtime_error
+            */
+            virtual void open(
+                const std::map<std::string, uint16_t>& value,
+                int32_t interfaceNumber,
+                const std::optional<bool>& detachKernelDriver
+            ) = 0;
+
+            virtual bool isOpen() = 0;
+
+            /*!
+            * Waits up to 'timeout' milliseconds for a device with the same vendor, product, bus and port (path) as 'value' to be connected.
+            * The address may differ after re-enumeration, '0' checks once without waiting.
+            *
+            * @return The connected device or an empty map on timeout.
+            *
+            * @throws std::runtime_error
+            */
+            virtual std::map<std::string, uint16_t> waitForDevice(
+                const std::map<std::string, uint16_t>& value,
+                uint32_t timeout
+            ) = 0;
+
+            /*!
+            * Leases a transfer buffer of at least 'capacity' bytes from the open device.
+            *
+            * @throws std::runtime_error
+            */
+            virtual Buffer allocateBuffer(size_t capacity) = 0;
+
+            /*!
+            * Performs a bulk transfer, direction is defined by the endpoint address.
+            * A transfer cancelled through 'token' (may be null) ends with 'LIBUSB_ERROR_INTERRUPTED'.
+            *
+            * @return A libusb error code.
+            */
+            virtual int bulkTransfer(
+                uint8_t endpoint,
+                uint8_t* data,
+                int32_t length,
+                int32_t* transferred,
+                uint32_t timeout,
+                const std::shared_ptr<CancellationToken>& token
+            ) = 0;
+
+            /*!
+            * Enables busy polling: transfers spin on the completion for up to 'value' microseconds
+            * before falling back to the blocking wait, '0' disables it.
+            */
+            virtual void setSpinBudget(uint32_t value) = 0;
+
+            virtual uint32_t getSpinBudget() = 0;
+
+            virtual PollStats getPollStats() = 0;
+
+            virtual void close() = 0;
+
+            virtual void destroy() = 0;
+
+            virtual ~ITransport() noexcept = default;
+
+    };
+
+}
@@ -0,0 +1,153 @@
+#include <bit>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/LibusbTransferPool.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    LibusbTransferPool::LibusbTransferPool(libusb_device_handle* handle, const Functions& functions): handle(handle), functions(functions) {
+        if (handle == nullptr) {
+            throw std::runtime_error(CALL_INFO + ": handle is null!");
+        }
+    }
+
+    LibusbTransferPool::LibusbTransferPool(libusb_device_handle* handle): LibusbTransferPool(handle, Functions {}) {}
+
+    libusb_device_handle* LibusbTransferPool::getHandle() {
+        try {
+            return handle;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    libusb_transfer* LibusbTransferPool::acquireTransfer() {
+        try {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!transfers.empty()) {
+                    libusb_transfer* result = transfers.back();
+                    transfers.pop_back();
+                    return result;
+                }
+            }
+            libusb_transfer* result = functions.allocTransfer();
+            if (result == nullptr) {
+                const char* libusbErrorName = libusb_error_name(LIBUSB_ERROR_NO_MEM);
+                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LibusbTransferPool::releaseTransfer(libusb_transfer* value) {
+        try {
+            if (value == nullptr) {
+                return;
+            }
+            value->flags = 0;
+            value->user_data = nullptr;
+            value->buffer = nullptr;
+            std::lock_guard<std::mutex> lock(mutex);
+            transfers.emplace_back(value);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Buffer LibusbTransferPool::acquireBuffer(size_t capacity) {
+        try {
+            size_t internalCapacity = toCapacity(capacity);
+            uint8_t* data = nullptr;
+            bool internalDeviceMemory = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::vector<std::pair<uint8_t*, bool>>& entries = buffers[internalCapacity];
+                if (!entries.empty()) {
+                    data = entries.back().first;
+                    internalDeviceMemory = entries.back().second;
+                    entries.pop_back();
+                }
+                if (data == nullptr && deviceMemory) {
+                    data = functions.devMemAlloc(handle, internalCapacity);
+                    if (data != nullptr) {
+                        internalDeviceMemory = true;
+                    } else {
+                        // not supported by the backend or the kernel, fall back to the heap from now on
+                        deviceMemory = false;
+                    }
+                }
+            }
+            if (data == nullptr) {
+                data = new uint8_t[internalCapacity];
+                internalDeviceMemory = false;
+            }
+            std::shared_ptr<LibusbTransferPool> self = shared_from_this();
+            return Buffer(
+                data,
+                internalCapacity,
+                internalDeviceMemory,
+                [self](uint8_t* data, size_t capacity, bool deviceMemory) {
+                    self->releaseBuffer(data, capacity, deviceMemory);
+                }
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    LibusbTransferPool::~LibusbTransferPool() noexcept {
+        for (libusb_transfer* transfer : transfers) {
+            functions.freeTransfer(transfer);
+        }
+        transfers.clear();
+        for (const auto& [capacity, entries] : buffers) {
+            for (const auto& [data, internalDeviceMemory] : entries) {
+                freeBuffer(data, capacity, internalDeviceMemory);
+            }
+        }
+        buffers.clear();
+        functions.close(handle);
+        handle = nullptr;
+    }
+
+    void LibusbTransferPool::releaseBuffer(uint8_t* data, size_t capacity, bool deviceMemory) noexcept {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<std::pair<uint8_t*, bool>>& entries = buffers[capacity];
+            if (entries.size() < MAX_FREE_BUFFERS) {
+                entries.emplace_back(data, deviceMemory);
+                return;
+            }
+        } catch (...) {
+        }
+        freeBuffer(data, capacity, deviceMemory);
+    }
+
+    void LibusbTransferPool::freeBuffer(uint8_t* data, size_t capacity, bool deviceMemory) noexcept {
+        if (deviceMemory) {
+            functions.devMemFree(handle, data, capacity);
+        } else {
+            delete[] data;
+        }
+    }
+
+    size_t LibusbTransferPool::toCapacity(size_t value) {
+        try {
+            if (value <= MIN_BUFFER_CAPACITY) {
+                return MIN_BUFFER_CAPACITY;
+            }
+            return std::bit_ceil(value);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <functional>
+
+#include <libusb.h>
+
+#include "exqudens/usb/Buffer.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Per-handle pool of 'libusb_transfer' objects and transfer buffers.
+    * Buffers are allocated with 'libusb_dev_mem_alloc' when the backend supports it, otherwise on the heap.
+    * The pool owns the device handle and closes it when the pool and every leased buffer are released.
+    */
+    class EXQUDENS_USB_EXPORT LibusbTransferPool: public std::enable_shared_from_this<LibusbTransferPool> {
+
+        public:
+
+            inline static const size_t MIN_BUFFER_CAPACITY = 512;
+            inline static const size_t MAX_FREE_BUFFERS = 8;
+
+            /*!
+            * The libusb calls of the pool, replaced by tests to run it without a device.
+            */
+            struct Functions {
+                std::function<libusb_transfer*()> allocTransfer = []() { return libusb_alloc_transfer(0); };
+                std::function<void(libusb_transfer* transfer)> freeTransfer = libusb_free_transfer;
+                std::function<uint8_t*(libusb_device_handle* handle, size_t length)> devMemAlloc = libusb_dev_mem_alloc; //!< Returns null if device memory is not supported.
+                std::function<int(libusb_device_handle* handle, uint8_t* data, size_t length)> devMemFree = libusb_dev_mem_free;
+                std::function<void(libusb_device_handle* handle)> close = libusb_close;
+            };
+
+        private:
+
+            libusb_device_handle* handle = nullptr;
+            Functions functions = {};
+            std::mutex mutex = {};
+            std::vector<libusb_transfer*> transfers = {};
+            std::map<size_t, std::vector<std::pair<uint8_t*, bool>>> buffers = {};
+            bool deviceMemory = true;
+
+        public:
+
+            LibusbTransferPool(libusb_device_handle* handle, const Functions& functions);
+            explicit LibusbTransferPool(libusb_device_handle* handle);
+
+            libusb_device_handle* getHandle();
+
+            libusb_transfer* acquireTransfer();
+
+            void releaseTransfer(libusb_transfer* value);
+
+            Buffer acquireBuffer(size_t capacity);
+
+            ~LibusbTransferPool() noexcept;
+
+        private:
+
+            void releaseBuffer(uint8_t* data, size_t capacity, bool deviceMemory) noexcept;
+
+            void freeBuffer(uint8_t* data, size_t capacity, bool deviceMemory) noexcept;
+
+            static size_t toCapacity(size_t value);
+
+    };
+
+}
@@ -0,0 +1,681 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/LibusbTransport.hpp"
+#include "exqudens/usb/ThreadTuning.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    LibusbTransport::LibusbTransport(const ThreadOptions& threadOptions): threadOptions(threadOptions), spinBudget(threadOptions.spinBudget) {}
+
+    LibusbTransport::LibusbTransport(): LibusbTransport(ThreadOptions {}) {}
+
+    std::string LibusbTransport::getName() {
+        try {
+            return std::string(NAME);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LibusbTransport::init() {
+        try {
+            if (context == nullptr) {
+                int libusbError = libusb_init(&context);
+                if (libusbError) {
+                    const char* libusbErrorName = libusb_error_name(libusbError);
+                    throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool LibusbTransport::isInitialized() {
+        try {
+            if (context == nullptr) {
+                return false;
+            } else {
+                return true;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> LibusbTransport::listDevices() {
+        try {
+            std::vector<std::map<std::string, uint16_t>> result = {};
+            libusb_device** libusbDevices;
+            ssize_t libusbDevicesSize = libusb_get_device_list(context, &libusbDevices);
+            for (ssize_t i = 0; i < libusbDevicesSize; i++) {
+                libusb_device* libusbDevice = libusbDevices[i];
+                std::map<std::string, uint16_t> entry = toMap(libusbDevice);
+                result.emplace_back(entry);
+            }
+            libusb_free_device_list(libusbDevices, 1);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> LibusbTransport::listDevices(const DeviceFilter& filter) {
+        try {
+            std::vector<std::map<std::string, uint16_t>> result = {};
+            libusb_device** libusbDevices;
+            ssize_t libusbDevicesSize = libusb_get_device_list(context, &libusbDevices);
+            if (libusbDevicesSize < 0) {
+                const char* libusbErrorName = libusb_error_name((int) libusbDevicesSize);
+                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+            try {
+                for (ssize_t i = 0; i < libusbDevicesSize; i++) {
+                    libusb_device* libusbDevice = libusbDevices[i];
+
+                    // topology comes from the enumeration, no I/O
+                    if (filter.bus && libusb_get_bus_number(libusbDevice) != filter.bus.value()) {
+                        continue;
+                    }
+                    if (!filter.portPath.empty()) {
+                        uint8_t portNumbers[8] = {0};
+                        int portNumbersSize = libusb_get_port_numbers(libusbDevice, portNumbers, (int) sizeof(portNumbers));
+                        if (portNumbersSize < (int) filter.portPath.size() || !std::equal(filter.portPath.begin(), filter.portPath.end(), portNumbers)) {
+                            continue;
+                        }
+                    }
+
+                    // the device descriptor is cached by libusb
+                    libusb_device_descriptor libusbDeviceDescriptor = {0};
+                    int libusbError = libusb_get_device_descriptor(libusbDevice, &libusbDeviceDescriptor);
+                    if (libusbError) {
+                        const char* libusbErrorName = libusb_error_name(libusbError);
+                        throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                    }
+                    if (!filter.vendors.empty() && !filter.vendors.contains(libusbDeviceDescriptor.idVendor)) {
+                        continue;
+                    }
+                    if (!filter.products.empty() && !filter.products.contains(libusbDeviceDescriptor.idProduct)) {
+                        continue;
+                    }
+                    if (filter.deviceClass && libusbDeviceDescriptor.bDeviceClass != filter.deviceClass.value()) {
+                        continue;
+                    }
+
+                    // string descriptors need the device open and a control transfer
+                    if (filter.serial && readString(libusbDevice, libusbDeviceDescriptor.iSerialNumber) != filter.serial) {
+                        continue;
+                    }
+
+                    result.emplace_back(toMap(libusbDevice, libusbDeviceDescriptor));
+                }
+            } catch (...) {
+                libusb_free_device_list(libusbDevices, 1);
+                throw;
+            }
+            libusb_free_device_list(libusbDevices, 1);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::string> LibusbTransport::getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) {
+        try {
+            if (!isInitialized()) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            libusb_device** libusbDevices;
+            ssize_t libusbDevicesSize = libusb_get_device_list(context, &libusbDevices);
+            if (libusbDevicesSize < 0) {
+                const char* libusbErrorName = libusb_error_name((int) libusbDevicesSize);
+                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+            try {
+                for (ssize_t i = 0; i < libusbDevicesSize; i++) {
+                    libusb_device* libusbDevice = libusbDevices[i];
+                    libusb_device_descriptor libusbDeviceDescriptor = {0};
+                    int libusbError = libusb_get_device_descriptor(libusbDevice, &libusbDeviceDescriptor);
+                    if (libusbError) {
+                        const char* libusbErrorName = libusb_error_name(libusbError);
+                        throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                    }
+                    if (!matches(device, toMap(libusbDevice, libusbDeviceDescriptor))) {
+                        continue;
+                    }
+                    uint8_t index = 0;
+                    if (type == StringDescriptor::MANUFACTURER) {
+                        index = libusbDeviceDescriptor.iManufacturer;
+                    } else if (type == StringDescriptor::PRODUCT) {
+                        index = libusbDeviceDescriptor.iProduct;
+                    } else {
+                        index = libusbDeviceDescriptor.iSerialNumber;
+                    }
+                    std::optional<std::string> result = readString(libusbDevice, index);
+                    libusb_free_device_list(libusbDevices, 1);
+                    return result;
+                }
+            } catch (...) {
+                libusb_free_device_list(libusbDevices, 1);
+                throw;
+            }
+            libusb_free_device_list(libusbDevices, 1);
+            throw std::runtime_error(CALL_INFO + ": device is not attached!");
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LibusbTransport::open(const std::map<std::string, uint16_t>& value, int32_t interfaceNumber, const std::optional<bool>& detachKernelDriver) {
+        try {
+            std::unique_lock<std::shared_mutex> lock(handleMutex);
+            if (handle != nullptr) {
+                throw std::runtime_error(CALL_INFO + ": the device is already open! call 'close' before...");
+            }
+
+            attachKernelDriver = false;
+
+            libusb_device** libusbDevices;
+            ssize_t libusbDevicesSize = libusb_get_device_list(context, &libusbDevices);
+            for (ssize_t i = 0; i < libusbDevicesSize; i++) {
+                libusb_device* libusbDevice = libusbDevices[i];
+                std::map<std::string, uint16_t> entry = toMap(libusbDevice);
+                if (matches(value, entry)) {
+                    int libusbError = libusb_open(libusbDevice, &handle);
+                    if (libusbError != 0) {
+                        libusb_free_device_list(libusbDevices, 1);
+                        const char* libusbErrorName = libusb_error_name(libusbError);
+                        throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                    }
+                    break;
+                }
+            }
+            libusb_free_device_list(libusbDevices, 1);
+
+            if (handle == nullptr) {
+                throw std::runtime_error(CALL_INFO + ": device handle is null!");
+            }
+
+            pool = std::make_shared<LibusbTransferPool>(handle);
+            {
+                std::lock_guard<std::mutex> inFlightLock(inFlightMutex);
+                closing = false;
+            }
+
+            this->interfaceNumber = interfaceNumber;
+            int libusbError = 0;
+
+            if (detachKernelDriver) {
+                if (detachKernelDriver.value()) {
+                    attachKernelDriver = true;
+                    libusbError = libusb_detach_kernel_driver(handle, this->interfaceNumber.value());
+                    if (libusbError != 0) {
+                        closeHandle();
+                        const char* libusbErrorName = libusb_error_name(libusbError);
+                        throw std::runtime_error(CALL_INFO + ": unable to detach kernel driver interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                    }
+                }
+            } else {
+                if (libusb_kernel_driver_active(handle, this->interfaceNumber.value()) == 1) {
+                    attachKernelDriver = true;
+                    libusbError = libusb_detach_kernel_driver(handle, this->interfaceNumber.value());
+                    if (libusbError != 0) {
+                        closeHandle();
+                        const char* libusbErrorName = libusb_error_name(libusbError);
+                        throw std::runtime_error(CALL_INFO + ": unable to detach kernel driver interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                    }
+                }
+            }
+
+            libusbError = libusb_claim_interface(handle, this->interfaceNumber.value());
+            if (libusbError != 0) {
+                closeHandle();
+                const char* libusbErrorName = libusb_error_name(libusbError);
+                throw std::runtime_error(CALL_INFO + ": unable to claim interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool LibusbTransport::isOpen() {
+        try {
+            std::shared_lock<std::shared_mutex> lock(handleMutex);
+            if (handle == nullptr) {
+                return false;
+            } else {
+                return true;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> LibusbTransport::waitForDevice(const std::map<std::string, uint16_t>& value, uint32_t timeout) {
+        try {
+            if (!isInitialized()) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+            if (!libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG)) {
+                while (true) {
+                    for (const std::map<std::string, uint16_t>& entry : listDevices()) {
+                        if (isSameDevice(entry, value)) {
+                            return entry;
+                        }
+                    }
+                    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                    if (now >= deadline) {
+                        return {};
+                    }
+                    std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, std::chrono::milliseconds(10)));
+                }
+            }
+
+            // 'LIBUSB_HOTPLUG_ENUMERATE' reports already connected devices from inside the register call
+            HotplugState state = {this, value, {}};
+            libusb_hotplug_callback_handle callbackHandle = 0;
+            int libusbError = libusb_hotplug_register_callback(
+                context,
+                LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED,
+                LIBUSB_HOTPLUG_ENUMERATE,
+                value.contains("vendor") ? value.at("vendor") : LIBUSB_HOTPLUG_MATCH_ANY,
+                value.contains("product") ? value.at("product") : LIBUSB_HOTPLUG_MATCH_ANY,
+                LIBUSB_HOTPLUG_MATCH_ANY,
+                &LibusbTransport::onHotplug,
+                &state,
+                &callbackHandle
+            );
+            if (libusbError) {
+                const char* libusbErrorName = libusb_error_name(libusbError);
+                throw std::runtime_error(CALL_INFO + ": unable to register hotplug callback libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+
+            while (state.found.empty()) {
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if (now >= deadline) {
+                    break;
+                }
+                std::chrono::microseconds remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+                timeval tv = {0};
+                tv.tv_sec = (decltype(tv.tv_sec)) (remaining.count() / 1000000);
+                tv.tv_usec = (decltype(tv.tv_usec)) (remaining.count() % 1000000);
+                libusbError = libusb_handle_events_timeout_completed(context, &tv, nullptr);
+                if (libusbError < 0 && libusbError != LIBUSB_ERROR_INTERRUPTED) {
+                    libusb_hotplug_deregister_callback(context, callbackHandle);
+                    const char* libusbErrorName = libusb_error_name(libusbError);
+                    throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                }
+            }
+
+            libusb_hotplug_deregister_callback(context, callbackHandle);
+
+            return state.found;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Buffer LibusbTransport::allocateBuffer(size_t capacity) {
+        try {
+            std::shared_lock<std::shared_mutex> lock(handleMutex);
+            if (handle == nullptr) {
+                throw std::runtime_error(CALL_INFO + ": the device is not open! call 'open' before...");
+            }
+            return pool->acquireBuffer(capacity);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    int LibusbTransport::bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            *transferred = 0;
+            // 'close' waits for the shared lock holders, the handle and the pool stay valid until the transfer is reaped
+            std::shared_lock<std::shared_mutex> lock(handleMutex);
+            if (handle == nullptr) {
+                return LIBUSB_ERROR_NO_DEVICE;
+            }
+            if (token && token->isCancelled()) {
+                return LIBUSB_ERROR_INTERRUPTED;
+            }
+            std::shared_ptr<LibusbTransferPool> transferPool = pool;
+            libusb_device_handle* transferHandle = handle;
+
+            // same as 'libusb_bulk_transfer' but the transfer object comes from the pool
+            libusb_transfer* transfer = transferPool->acquireTransfer();
+            int completed = 0;
+            libusb_fill_bulk_transfer(transfer, transferHandle, endpoint, data, length, &LibusbTransport::onTransferComplete, &completed, timeout);
+
+            int libusbError = 0;
+            {
+                // registered under the same lock 'close' cancels under, no transfer is submitted after that
+                std::lock_guard<std::mutex> inFlightLock(inFlightMutex);
+                if (closing) {
+                    transferPool->releaseTransfer(transfer);
+                    return LIBUSB_ERROR_NO_DEVICE;
+                }
+                libusbError = libusb_submit_transfer(transfer);
+                if (libusbError) {
+                    transferPool->releaseTransfer(transfer);
+                    return libusbError;
+                }
+                inFlight.insert(transfer);
+            }
+
+            // 'libusb_cancel_transfer' is thread safe, the completion is still reaped by the loop below
+            size_t subscription = token ? token->subscribe([transfer]() { libusb_cancel_transfer(transfer); }) : 0;
+
+            // busy poll with a zero timeout saves the wakeup of the blocking wait on fast completions
+            uint32_t budget = spinBudget.load(std::memory_order_relaxed);
+            if (budget > 0) {
+                timeval zero = {0, 0};
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(budget);
+                while (!completed && std::chrono::steady_clock::now() < deadline) {
+                    libusbError = libusb_handle_events_timeout_completed(context, &zero, &completed);
+                    if (libusbError < 0 && libusbError != LIBUSB_ERROR_INTERRUPTED) {
+                        break;
+                    }
+                }
+                (completed ? spinHits : spinMisses).fetch_add(1, std::memory_order_relaxed);
+            }
+
+            while (!completed) {
+                libusbError = libusb_handle_events_completed(context, &completed);
+                if (libusbError < 0) {
+                    if (libusbError == LIBUSB_ERROR_INTERRUPTED) {
+                        continue;
+                    }
+                    libusb_cancel_transfer(transfer);
+                    while (!completed) {
+                        if (libusb_handle_events_completed(context, &completed) < 0) {
+                            break;
+                        }
+                    }
+                    break;
+                }
+            }
+
+            if (token) {
+                token->unsubscribe(subscription);
+            }
+
+            bool closed = false;
+            {
+                std::lock_guard<std::mutex> inFlightLock(inFlightMutex);
+                inFlight.erase(transfer);
+                closed = closing;
+            }
+
+            *transferred = transfer->actual_length;
+            if (transfer->status == LIBUSB_TRANSFER_CANCELLED && token && token->isCancelled()) {
+                libusbError = LIBUSB_ERROR_INTERRUPTED;
+            } else if (transfer->status == LIBUSB_TRANSFER_CANCELLED && closed) {
+                libusbError = LIBUSB_ERROR_NO_DEVICE;
+            } else {
+                libusbError = toLibusbError(transfer->status);
+            }
+            transferPool->releaseTransfer(transfer);
+            return libusbError;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LibusbTransport::setSpinBudget(uint32_t value) {
+        try {
+            spinBudget = value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint32_t LibusbTransport::getSpinBudget() {
+        try {
+            return spinBudget;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    ITransport::PollStats LibusbTransport::getPollStats() {
+        try {
+            PollStats result = {};
+            result.spinHits = spinHits;
+            result.spinMisses = spinMisses;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    ThreadOptions LibusbTransport::getThreadOptions() {
+        try {
+            return threadOptions;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::string> LibusbTransport::tuneCurrentThread() {
+        try {
+            std::vector<std::string> result = ThreadTuning::apply(threadOptions);
+            std::lock_guard<std::mutex> lock(threadMutex);
+            threadErrors = result;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::string> LibusbTransport::getThreadErrors() {
+        try {
+            std::lock_guard<std::mutex> lock(threadMutex);
+            return threadErrors;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LibusbTransport::close() {
+        try {
+            // transfers without a timeout never return on their own, cancel them before waiting for them
+            {
+                std::lock_guard<std::mutex> inFlightLock(inFlightMutex);
+                closing = true;
+                for (libusb_transfer* transfer : inFlight) {
+                    libusb_cancel_transfer(transfer);
+                }
+            }
+            std::unique_lock<std::shared_mutex> lock(handleMutex);
+            if (handle != nullptr) {
+                int libusbError = libusb_release_interface(handle, interfaceNumber.value());
+                if (libusbError != 0) {
+                    closeHandle();
+                    const char* libusbErrorName = libusb_error_name(libusbError);
+                    throw std::runtime_error(CALL_INFO + ": unable to release interface: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                }
+                if (attachKernelDriver) {
+                    libusbError = libusb_attach_kernel_driver(handle, interfaceNumber.value());
+                    if (libusbError != 0) {
+                        closeHandle();
+                        const char* libusbErrorName = libusb_error_name(libusbError);
+                        throw std::runtime_error(CALL_INFO + ": unable to attach kernel driver: " + std::to_string(this->interfaceNumber.value()) + " libusbErrorName: '" + std::string(libusbErrorName) + "'");
+                    }
+                }
+                closeHandle();
+            }
+            attachKernelDriver = false;
+            interfaceNumber = {};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LibusbTransport::destroy() {
+        try {
+            if (context != nullptr) {
+                libusb_exit(context);
+                context = nullptr;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LibusbTransport::closeHandle() {
+        try {
+            // the pool closes the handle once every leased buffer is released
+            if (pool) {
+                pool = nullptr;
+            } else if (handle != nullptr) {
+                libusb_close(handle);
+            }
+            handle = nullptr;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> LibusbTransport::toMap(libusb_device* libusbDevice) {
+        try {
+            libusb_device_descriptor libusbDeviceDescriptor = {0};
+            int libusbError = libusb_get_device_descriptor(libusbDevice, &libusbDeviceDescriptor);
+            if (libusbError) {
+                const char* libusbErrorName = libusb_error_name(libusbError);
+                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+            return toMap(libusbDevice, libusbDeviceDescriptor);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> LibusbTransport::toMap(libusb_device* libusbDevice, const libusb_device_descriptor& libusbDeviceDescriptor) {
+        try {
+            std::map<std::string, uint16_t> result = {};
+
+            uint16_t vendor = libusbDeviceDescriptor.idVendor;
+            uint16_t product = libusbDeviceDescriptor.idProduct;
+            uint16_t port = libusb_get_port_number(libusbDevice);
+            uint16_t bus = libusb_get_bus_number(libusbDevice);
+            uint16_t address = libusb_get_device_address(libusbDevice);
+
+            result.insert({"vendor", vendor});
+            result.insert({"product", product});
+            result.insert({"port", port});
+            result.insert({"bus", bus});
+            result.insert({"address", address});
+
+            // 'port' alone is ambiguous behind hubs, the full path from the root hub is 'portPath0', 'portPath1', ...
+            uint8_t portNumbers[8] = {0};
+            int portNumbersSize = libusb_get_port_numbers(libusbDevice, portNumbers, (int) sizeof(portNumbers));
+            for (int i = 0; i < portNumbersSize; i++) {
+                result.insert({"portPath" + std::to_string(i), portNumbers[i]});
+            }
+
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::string> LibusbTransport::readString(libusb_device* libusbDevice, uint8_t index) {
+        try {
+            if (index == 0) {
+                return {};
+            }
+            // the open device is read through its handle, others are opened for the read
+            std::shared_lock<std::shared_mutex> lock(handleMutex);
+            libusb_device_handle* libusbHandle = handle != nullptr && libusb_get_device(handle) == libusbDevice ? handle : nullptr;
+            bool owned = libusbHandle == nullptr;
+            // devices that can not be opened (e.g. no permission) have no strings
+            if (owned && libusb_open(libusbDevice, &libusbHandle) != 0) {
+                return {};
+            }
+            unsigned char data[256] = {0};
+            int size = libusb_get_string_descriptor_ascii(libusbHandle, index, data, (int) sizeof(data));
+            if (owned) {
+                libusb_close(libusbHandle);
+            }
+            if (size < 0) {
+                return {};
+            }
+            return std::string((const char*) data, (size_t) size);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool LibusbTransport::isSameDevice(const std::map<std::string, uint16_t>& value, const std::map<std::string, uint16_t>& other) {
+        try {
+            // everything but the address, which changes on re-enumeration, the port path only where both have it
+            for (const std::map<std::string, uint16_t>* entry : {&value, &other}) {
+                for (const auto& [key, number] : *entry) {
+                    if (key == "address" || (key.starts_with("portPath") && value.contains(key) != other.contains(key))) {
+                        continue;
+                    }
+                    if (value.contains(key) != other.contains(key) || value.at(key) != other.at(key)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LIBUSB_CALL LibusbTransport::onTransferComplete(libusb_transfer* transfer) {
+        int* completed = (int*) transfer->user_data;
+        *completed = 1;
+    }
+
+    int LIBUSB_CALL LibusbTransport::onHotplug(libusb_context*, libusb_device* device, libusb_hotplug_event, void* userData) {
+        HotplugState* state = (HotplugState*) userData;
+        try {
+            std::map<std::string, uint16_t> entry = state->transport->toMap(device);
+            if (state->found.empty() && isSameDevice(entry, state->expected)) {
+                state->found = entry;
+            }
+        } catch (...) {
+        }
+        // keep the callback registered, 'waitForDevice' deregisters it
+        return 0;
+    }
+
+    int LibusbTransport::toLibusbError(libusb_transfer_status value) {
+        try {
+            switch (value) {
+                case LIBUSB_TRANSFER_COMPLETED:
+                    return LIBUSB_SUCCESS;
+                case LIBUSB_TRANSFER_TIMED_OUT:
+                    return LIBUSB_ERROR_TIMEOUT;
+                case LIBUSB_TRANSFER_STALL:
+                    return LIBUSB_ERROR_PIPE;
+                case LIBUSB_TRANSFER_OVERFLOW:
+                    return LIBUSB_ERROR_OVERFLOW;
+                case LIBUSB_TRANSFER_NO_DEVICE:
+                    return LIBUSB_ERROR_NO_DEVICE;
+                case LIBUSB_TRANSFER_ERROR:
+                case LIBUSB_TRANSFER_CANCELLED:
+                    return LIBUSB_ERROR_IO;
+                default:
+                    return LIBUSB_ERROR_OTHER;
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
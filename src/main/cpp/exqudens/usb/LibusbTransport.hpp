@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <set>
+
+#include <libusb.h>
+
+#include "exqudens/usb/ITransport.hpp"
+#include "exqudens/usb/LibusbTransferPool.hpp"
+#include "exqudens/usb/ThreadOptions.hpp"
+
+namespace exqudens::usb {
+
+    class EXQUDENS_USB_EXPORT LibusbTransport: public virtual ITransport {
+
+        public:
+
+            inline static const char* NAME = "libusb";
+
+        private:
+
+            struct HotplugState {
+                LibusbTransport* transport = nullptr;
+                std::map<std::string, uint16_t> expected = {};
+                std::map<std::string, uint16_t> found = {};
+            };
+
+            libusb_context* context = nullptr;
+            bool attachKernelDriver = false;
+            std::optional<int32_t> interfaceNumber = {};
+            libusb_device_handle* handle = nullptr;
+            std::shared_ptr<LibusbTransferPool> pool = nullptr;
+            std::shared_mutex handleMutex = {}; //!< held shared by transfers, exclusive by 'open' and 'close'
+            std::mutex inFlightMutex = {};
+            std::set<libusb_transfer*> inFlight = {};
+            bool closing = false;
+            ThreadOptions threadOptions = {};
+            std::mutex threadMutex = {};
+            std::vector<std::string> threadErrors = {};
+            std::atomic<uint32_t> spinBudget = 0;
+            std::atomic<uint64_t> spinHits = 0;
+            std::atomic<uint64_t> spinMisses = 0;
+
+        public:
+
+            explicit LibusbTransport(const ThreadOptions& threadOptions);
+            LibusbTransport();
+
+            std::string getName() override;
+
+            void init() override;
+
+            bool isInitialized() override;
+
+            std::vector<std::map<std::string, uint16_t>> listDevices() override;
+            std::vector<std::map<std::string, uint16_t>> listDevices(const DeviceFilter& filter) override;
+
+            std::optional<std::string> getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) override;
+
+            void open(const std::map<std::string, uint16_t>& value, int32_t interfaceNumber, const std::optional<bool>& detachKernelDriver) override;
+
+            bool isOpen() override;
+
+            std::map<std::string, uint16_t> waitForDevice(const std::map<std::string, uint16_t>& value, uint32_t timeout) override;
+
+            Buffer allocateBuffer(size_t capacity) override;
+
+            int bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) override;
+
+            void setSpinBudget(uint32_t value) override;
+
+            uint32_t getSpinBudget() override;
+
+            PollStats getPollStats() override;
+
+            ThreadOptions getThreadOptions();
+
+            /*!
+            * Applies the thread options to the calling thread, e.g. a dedicated thread doing every transfer of the device.
+            * Nothing is tuned implicitly, threads calling the transport keep their scheduling unless they call this.
+            *
+            * @return Options that could not be applied, also returned by 'getThreadErrors'.
+            *
+            * @throws std::runtime_error If 'ThreadOptions::strict' is set and an option could not be applied.
+            */
+            std::vector<std::string> tuneCurrentThread();
+
+            /*!
+            * @return Thread options that could not be applied by the last 'tuneCurrentThread', empty if every option is applied.
+            */
+            std::vector<std::string> getThreadErrors();
+
+            void close() override;
+
+            void destroy() override;
+
+            ~LibusbTransport() noexcept override = default;
+
+        private:
+
+            void closeHandle();
+
+            std::map<std::string, uint16_t> toMap(libusb_device* libusbDevice);
+            std::map<std::string, uint16_t> toMap(libusb_device* libusbDevice, const libusb_device_descriptor& libusbDeviceDescriptor);
+
+            std::optional<std::string> readString(libusb_device* libusbDevice, uint8_t index);
+
+            static bool isSameDevice(const std::map<std::string, uint16_t>& value, const std::map<std::string, uint16_t>& other);
+
+            static void LIBUSB_CALL onTransferComplete(libusb_transfer* transfer);
+
+            static int LIBUSB_CALL onHotplug(libusb_context* context, libusb_device* device, libusb_hotplug_event event, void* userData);
+
+            static int toLibusbError(libusb_transfer_status value);
+
+    };
+
+}
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/PriorityWriter.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    PriorityWriter::PriorityWriter(
+        const std::shared_ptr<IClient>& client,
+        uint8_t endpoint,
+        const Options& options
+    ):
+        client(client),
+        endpoint(endpoint),
+        options(options)
+    {
+        try {
+            if (!this->client) {
+                throw std::runtime_error(CALL_INFO + ": client is null!");
+            }
+            if (options.starvationLimit == 0) {
+                throw std::runtime_error(CALL_INFO + ": starvationLimit must be greater zero!");
+            }
+            for (Priority priority : {Priority::HIGH, Priority::NORMAL, Priority::LOW}) {
+                classes[priority] = {};
+            }
+            thread = std::thread(&PriorityWriter::run, this);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    PriorityWriter::PriorityWriter(const std::shared_ptr<IClient>& client, uint8_t endpoint): PriorityWriter(client, endpoint, Options()) {}
+
+    void PriorityWriter::submit(const std::vector<uint8_t>& value, Priority priority, const std::function<void(std::exception_ptr error)>& callback) {
+        try {
+            throwError();
+            if (value.empty()) {
+                throw std::runtime_error(CALL_INFO + ": value is empty!");
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                Class& queue = classes.at(priority);
+                Entry entry = {};
+                entry.data = value;
+                entry.callback = callback;
+                entry.submittedAt = std::chrono::steady_clock::now();
+                queue.entries.emplace_back(std::move(entry));
+                queue.metrics.queueDepth++;
+                queue.metrics.maxQueueDepth = std::max(queue.metrics.maxQueueDepth, queue.metrics.queueDepth);
+            }
+            condition.notify_all();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void PriorityWriter::submit(const std::vector<uint8_t>& value, Priority priority) {
+        try {
+            submit(value, priority, {});
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void PriorityWriter::flush() {
+        try {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                idleCondition.wait(lock, [this]() { return isEmpty(); });
+            }
+            throwError();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<PriorityWriter::Priority, PriorityWriter::ClassMetrics> PriorityWriter::getMetrics() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::map<Priority, ClassMetrics> result = {};
+            for (const auto& [priority, queue] : classes) {
+                ClassMetrics metrics = queue.metrics;
+                if (queue.started > 0) {
+                    metrics.averageWait = queue.totalWait / queue.started;
+                }
+                result[priority] = metrics;
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    PriorityWriter::~PriorityWriter() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    void PriorityWriter::run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            condition.wait(lock, [this]() { return stopped || !isEmpty(); });
+            if (isEmpty()) {
+                return;
+            }
+
+            Class& queue = classes.at(select());
+            // deque references survive 'submit' appending while the lock is released
+            Entry& entry = queue.entries.front();
+            if (entry.offset == 0) {
+                std::chrono::microseconds wait = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - entry.submittedAt);
+                queue.started++;
+                queue.totalWait += wait;
+                queue.metrics.maxWait = std::max(queue.metrics.maxWait, wait);
+            }
+            size_t size = entry.data.size() - entry.offset;
+            if (options.chunkSize > 0) {
+                size = std::min(size, options.chunkSize);
+            }
+            lock.unlock();
+
+            size_t written = 0;
+            std::exception_ptr failure = nullptr;
+            try {
+                Buffer buffer(entry.data.data() + entry.offset, size, false, {});
+                buffer.setSize(size);
+                written = client->bulkWrite(buffer, endpoint, options.timeout, false);
+                if (written == 0) {
+                    throw std::runtime_error(CALL_INFO + ": nothing written of: " + std::to_string(size) + " bytes");
+                }
+            } catch (...) {
+                failure = std::current_exception();
+            }
+
+            lock.lock();
+            entry.offset += written;
+            if (!failure && entry.offset < entry.data.size()) {
+                continue;
+            }
+            Entry done = std::move(entry);
+            queue.entries.pop_front();
+            queue.passed = 0;
+            queue.metrics.queueDepth--;
+            (failure ? queue.metrics.failed : queue.metrics.completed)++;
+            if (failure && !done.callback && !error) {
+                error = failure;
+            }
+            lock.unlock();
+            if (done.callback) {
+                try {
+                    done.callback(failure);
+                } catch (...) {
+                }
+            }
+            idleCondition.notify_all();
+            lock.lock();
+        }
+    }
+
+    bool PriorityWriter::isEmpty() {
+        for (const auto& [priority, queue] : classes) {
+            if (!queue.entries.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    PriorityWriter::Priority PriorityWriter::select() {
+        try {
+            // 'classes' is ordered from 'HIGH' to 'LOW'
+            Priority result = Priority::LOW;
+            for (const auto& [priority, queue] : classes) {
+                if (!queue.entries.empty()) {
+                    result = priority;
+                    break;
+                }
+            }
+            // a chunked message goes ahead for one chunk only, then waits for the limit again
+            for (auto& [priority, queue] : classes) {
+                if (priority > result && !queue.entries.empty() && queue.passed >= options.starvationLimit) {
+                    result = priority;
+                    queue.passed = 0;
+                    break;
+                }
+            }
+            for (auto& [priority, queue] : classes) {
+                if (priority > result && !queue.entries.empty()) {
+                    queue.passed++;
+                }
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void PriorityWriter::throwError() {
+        try {
+            std::exception_ptr value = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::swap(value, error);
+            }
+            if (value) {
+                std::rethrow_exception(value);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO + ": queued write failed"));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Queues writes to one OUT endpoint and sends them from a single thread, highest priority class first.
+    * A message waiting in a lower class is passed over by at most 'Options::starvationLimit' transfers,
+    * then it goes ahead of the higher classes for one transfer (one chunk of a chunked message).
+    * Thread safe. A failed message is reported to its callback, without a callback the error is thrown by the next call.
+    */
+    class EXQUDENS_USB_EXPORT PriorityWriter {
+
+        public:
+
+            enum class Priority {
+                HIGH, //!< Latency sensitive commands.
+                NORMAL,
+                LOW //!< Bulk data.
+            };
+
+            struct Options {
+                uint32_t timeout = 1000; //!< Per transfer, '0' for unlimited.
+                size_t starvationLimit = 16; //!< Transfers of higher classes a waiting message is passed over by.
+                size_t chunkSize = 0; //!< Larger messages are written in chunks of this size, so a high priority message waits for one chunk only. Only for devices framing the stream themselves, '0' writes whole messages.
+            };
+
+            struct ClassMetrics {
+                size_t queueDepth = 0; //!< Queued, not completed messages.
+                size_t maxQueueDepth = 0;
+                size_t completed = 0;
+                size_t failed = 0;
+                std::chrono::microseconds averageWait = std::chrono::microseconds(0); //!< From 'submit' to the first transfer of the message.
+                std::chrono::microseconds maxWait = std::chrono::microseconds(0);
+            };
+
+        private:
+
+            struct Entry {
+                std::vector<uint8_t> data = {};
+                size_t offset = 0; //!< Bytes already written.
+                std::function<void(std::exception_ptr error)> callback = {};
+                std::chrono::steady_clock::time_point submittedAt = {};
+            };
+
+            struct Class {
+                std::deque<Entry> entries = {};
+                size_t passed = 0; //!< Transfers of higher classes since the front entry started waiting or last went ahead of them.
+                size_t started = 0;
+                ClassMetrics metrics = {};
+                std::chrono::microseconds totalWait = std::chrono::microseconds(0);
+            };
+
+            std::shared_ptr<IClient> client = nullptr;
+            uint8_t endpoint = 0;
+            Options options = {};
+            std::map<Priority, Class> classes = {};
+            std::mutex mutex = {};
+            std::condition_variable condition = {};
+            std::condition_variable idleCondition = {};
+            std::exception_ptr error = nullptr;
+            bool stopped = false;
+            std::thread thread = {};
+
+        public:
+
+            PriorityWriter(
+                const std::shared_ptr<IClient>& client,
+                uint8_t endpoint, //!< OUT endpoint address, e.g. '0x01'.
+                const Options& options
+            );
+            PriorityWriter(const std::shared_ptr<IClient>& client, uint8_t endpoint);
+            PriorityWriter(const PriorityWriter& other) = delete;
+
+            PriorityWriter& operator=(const PriorityWriter& other) = delete;
+
+            /*!
+            * Queues 'value' behind the messages of the same class.
+            * 'callback' runs on the sender thread once the message is written or failed ('error' is null on success).
+            *
+            * @throws std::runtime_error
+            */
+            void submit(const std::vector<uint8_t>& value, Priority priority, const std::function<void(std::exception_ptr error)>& callback);
+            void submit(const std::vector<uint8_t>& value, Priority priority);
+
+            /*!
+            * Waits until every queued message is written.
+            *
+            * @throws std::runtime_error
+            */
+            void flush();
+
+            std::map<Priority, ClassMetrics> getMetrics();
+
+            /*!
+            * Writes the queued messages and stops the sender thread, errors are ignored.
+            */
+            ~PriorityWriter() noexcept;
+
+        private:
+
+            void run();
+
+            bool isEmpty();
+
+            Priority select();
+
+            void throwError();
+
+    };
+
+}
@@ -0,0 +1,19 @@
+#include "exqudens/usb/Probes.hpp"
+
+#if defined(EXQUDENS_USB_USDT) && __has_include(<sys/sdt.h>)
+
+// incremented by the tracer on attach, 'sys/sdt.h' expects them in the '.probes' section
+#define EXQUDENS_USB_SEMAPHORE __attribute__((unused)) __attribute__((section(".probes")))
+
+extern "C" {
+    volatile unsigned short exqudens_usb_init_semaphore EXQUDENS_USB_SEMAPHORE = 0;
+    volatile unsigned short exqudens_usb_list_devices_semaphore EXQUDENS_USB_SEMAPHORE = 0;
+    volatile unsigned short exqudens_usb_open_semaphore EXQUDENS_USB_SEMAPHORE = 0;
+    volatile unsigned short exqudens_usb_close_semaphore EXQUDENS_USB_SEMAPHORE = 0;
+    volatile unsigned short exqudens_usb_transfer_submit_semaphore EXQUDENS_USB_SEMAPHORE = 0;
+    volatile unsigned short exqudens_usb_transfer_complete_semaphore EXQUDENS_USB_SEMAPHORE = 0;
+}
+
+#undef EXQUDENS_USB_SEMAPHORE
+
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+/*!
+* USDT probes of the provider 'exqudens_usb' for bpftrace/perf, internal to the library sources.
+* Compiled in by the CMake option 'USE_USDT' when 'sys/sdt.h' is available, otherwise every probe is a no-op.
+* A probe site is a single 'nop' until a tracer attaches, arguments that cost something to compute (durations)
+* are guarded by 'EXQUDENS_USB_PROBE_ENABLED' which reads the probe semaphore the tracer increments.
+*
+* Probes:
+* - 'init'
+* - 'list_devices(count, durationNs)'
+* - 'open(vendor, product, bus, address)'
+* - 'close'
+* - 'transfer_submit(endpoint, length)'
+* - 'transfer_complete(endpoint, transferred, libusbError, durationNs)'
+*/
+#if defined(EXQUDENS_USB_USDT) && __has_include(<sys/sdt.h>)
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+extern "C" {
+    extern volatile unsigned short exqudens_usb_init_semaphore;
+    extern volatile unsigned short exqudens_usb_list_devices_semaphore;
+    extern volatile unsigned short exqudens_usb_open_semaphore;
+    extern volatile unsigned short exqudens_usb_close_semaphore;
+    extern volatile unsigned short exqudens_usb_transfer_submit_semaphore;
+    extern volatile unsigned short exqudens_usb_transfer_complete_semaphore;
+}
+
+#define EXQUDENS_USB_PROBE_ENABLED(name) (exqudens_usb_##name##_semaphore != 0)
+#define EXQUDENS_USB_PROBE0(name) DTRACE_PROBE(exqudens_usb, name)
+#define EXQUDENS_USB_PROBE2(name, arg1, arg2) DTRACE_PROBE2(exqudens_usb, name, arg1, arg2)
+#define EXQUDENS_USB_PROBE4(name, arg1, arg2, arg3, arg4) DTRACE_PROBE4(exqudens_usb, name, arg1, arg2, arg3, arg4)
+
+#else
+
+#define EXQUDENS_USB_PROBE_ENABLED(name) false
+#define EXQUDENS_USB_PROBE0(name) do {} while (false)
+// 'sizeof' marks the arguments used without evaluating them
+#define EXQUDENS_USB_PROBE2(name, arg1, arg2) do { (void) sizeof(arg1); (void) sizeof(arg2); } while (false)
+#define EXQUDENS_USB_PROBE4(name, arg1, arg2, arg3, arg4) do { (void) sizeof(arg1); (void) sizeof(arg2); (void) sizeof(arg3); (void) sizeof(arg4); } while (false)
+
+#endif
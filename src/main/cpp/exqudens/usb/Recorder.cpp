@@ -0,0 +1,247 @@
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/Recorder.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    Recorder::Recorder(
+        const std::shared_ptr<IClient>& client,
+        uint8_t endpoint,
+        const Options& options
+    ):
+        client(client),
+        endpoint(endpoint),
+        options(options)
+    {
+        try {
+            if (!this->client) {
+                throw std::runtime_error(CALL_INFO + ": client is null!");
+            }
+            if (options.bufferSize == 0 || options.bufferCount == 0) {
+                throw std::runtime_error(CALL_INFO + ": bufferSize and bufferCount must be greater zero!");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void Recorder::start() {
+        try {
+            if (isRunning()) {
+                throw std::runtime_error(CALL_INFO + ": already running! call 'stop' before...");
+            }
+            std::filesystem::create_directories(options.directory);
+            buffers.clear();
+            freeBuffers.clear();
+            filledBuffers.clear();
+            for (size_t i = 0; i < options.bufferCount; i++) {
+                buffers.emplace_back(client->allocateBuffer(options.bufferSize));
+                freeBuffers.emplace_back(i);
+            }
+            files.clear();
+            fileBytes = 0;
+            rotate();
+            bytesRead = 0;
+            bytesWritten = 0;
+            transferCount = 0;
+            overrunCount = 0;
+            error = nullptr;
+            stopping = false;
+            reading = true;
+            token = std::make_shared<CancellationToken>();
+            readerThread = std::thread(&Recorder::read, this);
+            writerThread = std::thread(&Recorder::write, this);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool Recorder::isRunning() {
+        try {
+            return readerThread.joinable() || writerThread.joinable();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void Recorder::stop() {
+        try {
+            if (!isRunning()) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            condition.notify_all();
+            token->cancel();
+            readerThread.join();
+            writerThread.join();
+            if (file != nullptr) {
+                std::fclose(file);
+                file = nullptr;
+            }
+            buffers.clear();
+            freeBuffers.clear();
+            filledBuffers.clear();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Recorder::Stats Recorder::getStats() {
+        try {
+            Stats result = {};
+            result.bytesRead = bytesRead;
+            result.bytesWritten = bytesWritten;
+            result.transferCount = transferCount;
+            result.overrunCount = overrunCount;
+            std::lock_guard<std::mutex> lock(mutex);
+            result.files = files;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Recorder::~Recorder() noexcept {
+        try {
+            stop();
+        } catch (...) {
+        }
+    }
+
+    void Recorder::read() {
+        try {
+            while (true) {
+                size_t index = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if (freeBuffers.empty() && !stopping) {
+                        overrunCount++;
+                        condition.wait(lock, [this]() { return stopping || !freeBuffers.empty(); });
+                    }
+                    if (stopping) {
+                        break;
+                    }
+                    index = freeBuffers.front();
+                    freeBuffers.pop_front();
+                }
+                // unlimited wait, 'stop' cancels the in-flight read through the token
+                size_t size = 0;
+                try {
+                    size = client->bulkRead(buffers.at(index), endpoint, std::chrono::steady_clock::time_point::max(), token);
+                } catch (...) {
+                    if (token->isCancelled()) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        freeBuffers.emplace_back(index);
+                        break;
+                    }
+                    throw;
+                }
+                bytesRead += size;
+                transferCount++;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    (size > 0 ? filledBuffers : freeBuffers).emplace_back(index);
+                }
+                condition.notify_all();
+            }
+        } catch (...) {
+            fail();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            reading = false;
+        }
+        condition.notify_all();
+    }
+
+    void Recorder::write() {
+        try {
+            while (true) {
+                size_t index = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    // filled buffers are written even after 'stop', nothing read is dropped
+                    condition.wait(lock, [this]() { return !reading || !filledBuffers.empty(); });
+                    if (filledBuffers.empty()) {
+                        break;
+                    }
+                    index = filledBuffers.front();
+                    filledBuffers.pop_front();
+                }
+                writeBuffer(buffers.at(index));
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    freeBuffers.emplace_back(index);
+                }
+                condition.notify_all();
+            }
+        } catch (...) {
+            fail();
+        }
+    }
+
+    void Recorder::writeBuffer(Buffer& value) {
+        try {
+            if (options.fileSize > 0 && fileBytes > 0 && fileBytes + value.getSize() > options.fileSize) {
+                rotate();
+            }
+            if (std::fwrite(value.getData(), 1, value.getSize(), file) != value.getSize()) {
+                throw std::runtime_error(CALL_INFO + ": can not write: '" + files.back() + "'");
+            }
+            fileBytes += value.getSize();
+            bytesWritten += value.getSize();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void Recorder::rotate() {
+        try {
+            if (file != nullptr) {
+                std::fclose(file);
+                file = nullptr;
+            }
+            std::ostringstream name;
+            name << options.prefix << "-" << std::setw(6) << std::setfill('0') << files.size() << ".bin";
+            std::string path = (std::filesystem::path(options.directory) / name.str()).generic_string();
+            file = std::fopen(path.c_str(), "wb");
+            if (file == nullptr) {
+                throw std::runtime_error(CALL_INFO + ": can not open: '" + path + "'");
+            }
+            // the buffers are large already, the stdio buffer would only add a copy
+            std::setvbuf(file, nullptr, _IONBF, 0);
+            fileBytes = 0;
+            std::lock_guard<std::mutex> lock(mutex);
+            files.emplace_back(path);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void Recorder::fail() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            stopping = true;
+            reading = false;
+        }
+        condition.notify_all();
+        token->cancel();
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Continuous capture of a bulk IN endpoint to disk.
+    * A reader thread fills a ring of transfer buffers leased from the client, a writer thread writes them out and returns them,
+    * so the data is copied once (device to buffer) and a slow disk write does not delay the next read.
+    * Files are rotated at 'Options::fileSize', a read that has to wait for a free buffer is counted as overrun.
+    */
+    class EXQUDENS_USB_EXPORT Recorder {
+
+        public:
+
+            struct Options {
+                std::string directory = ".";
+                std::string prefix = "capture"; //!< Files are named 'prefix-000000.bin', 'prefix-000001.bin', ...
+                size_t bufferSize = 1 << 20; //!< Bytes per transfer, a multiple of the packet size.
+                size_t bufferCount = 8;
+                uint64_t fileSize = 1ULL << 30; //!< Rotation size, '0' for a single file.
+            };
+
+            struct Stats {
+                uint64_t bytesRead = 0;
+                uint64_t bytesWritten = 0;
+                uint64_t transferCount = 0;
+                uint64_t overrunCount = 0; //!< Reads delayed because every buffer was waiting for the disk.
+                std::vector<std::string> files = {};
+            };
+
+        private:
+
+            std::shared_ptr<IClient> client = nullptr;
+            uint8_t endpoint = 0;
+            Options options = {};
+            std::vector<Buffer> buffers = {};
+            std::deque<size_t> freeBuffers = {};
+            std::deque<size_t> filledBuffers = {};
+            std::shared_ptr<CancellationToken> token = nullptr;
+            std::mutex mutex = {};
+            std::condition_variable condition = {};
+            std::FILE* file = nullptr;
+            uint64_t fileBytes = 0;
+            std::vector<std::string> files = {};
+            std::atomic<uint64_t> bytesRead = 0;
+            std::atomic<uint64_t> bytesWritten = 0;
+            std::atomic<uint64_t> transferCount = 0;
+            std::atomic<uint64_t> overrunCount = 0;
+            std::exception_ptr error = nullptr;
+            bool stopping = false;
+            bool reading = false;
+            std::thread readerThread = {};
+            std::thread writerThread = {};
+
+        public:
+
+            Recorder(
+                const std::shared_ptr<IClient>& client,
+                uint8_t endpoint, //!< IN endpoint address, e.g. '0x81'.
+                const Options& options
+            );
+            Recorder(const Recorder& other) = delete;
+
+            Recorder& operator=(const Recorder& other) = delete;
+
+            /*!
+            * Leases the buffers from the open client and starts the capture.
+            *
+            * @throws std::runtime_error
+            */
+            void start();
+
+            bool isRunning();
+
+            /*!
+            * Cancels the in-flight read, writes every filled buffer and closes the file.
+            *
+            * @throws std::runtime_error If the capture failed.
+            */
+            void stop();
+
+            Stats getStats();
+
+            ~Recorder() noexcept;
+
+        private:
+
+            void read();
+
+            void write();
+
+            void writeBuffer(Buffer& value);
+
+            void rotate();
+
+            void fail();
+
+    };
+
+}
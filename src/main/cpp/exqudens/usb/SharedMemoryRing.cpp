@@ -0,0 +1,499 @@
+#include <cstring>
+#include <atomic>
+#include <filesystem>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "exqudens/usb/SharedMemoryRing.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+#if defined(__linux__)
+
+    namespace {
+
+        constexpr char MAGIC[8] = {'E', 'X', 'Q', 'U', 'S', 'B', 'R', 'G'};
+        constexpr uint32_t VERSION = 2;
+        constexpr uint32_t PADDING = UINT32_MAX; //!< Record size marking the unused end of the ring, readers wrap to offset '0'.
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t closed;
+            uint64_t capacity;
+            uint64_t head; //!< Oldest record, positions grow monotonically and are taken modulo 'capacity'.
+            uint64_t tail; //!< End of the newest record.
+            uint64_t metadataSize;
+            uint64_t process; //!< Id of the creating process, a ring it left behind by crashing stays linked.
+            pthread_mutex_t mutex;
+            pthread_cond_t condition;
+            char metadata[SharedMemoryRing::METADATA_CAPACITY];
+        };
+
+        struct RecordHeader {
+            uint32_t size;
+            uint32_t tag;
+        };
+
+        constexpr size_t DATA_OFFSET = (sizeof(Header) + 63) / 64 * 64;
+
+        Header& toHeader(void* memory) {
+            return *static_cast<Header*>(memory);
+        }
+
+        uint8_t* toData(void* memory) {
+            return static_cast<uint8_t*>(memory) + DATA_OFFSET;
+        }
+
+        size_t toLength(size_t size) {
+            return sizeof(RecordHeader) + (size + 7) / 8 * 8;
+        }
+
+        RecordHeader& toRecord(void* memory, uint64_t position) {
+            return *reinterpret_cast<RecordHeader*>(toData(memory) + position % toHeader(memory).capacity);
+        }
+
+        // 'head' or a reader cursor past a padding record, the next record starts at offset '0'
+        uint64_t skipPadding(void* memory, uint64_t position, uint64_t tail) {
+            uint64_t capacity = toHeader(memory).capacity;
+            while (position < tail && toRecord(memory, position).size == PADDING) {
+                position += capacity - position % capacity;
+            }
+            return position;
+        }
+
+        class Lock {
+
+            private:
+
+                pthread_mutex_t* mutex = nullptr;
+
+            public:
+
+                explicit Lock(Header& header): mutex(&header.mutex) {
+                    int result = pthread_mutex_lock(mutex);
+                    // a process died holding the lock, the ring data is only changed by complete updates
+                    if (result == EOWNERDEAD) {
+                        pthread_mutex_consistent(mutex);
+                    } else if (result != 0) {
+                        throw std::runtime_error(CALL_INFO + ": pthread_mutex_lock: " + std::string(std::strerror(result)));
+                    }
+                }
+
+                Lock(const Lock& other) = delete;
+
+                Lock& operator=(const Lock& other) = delete;
+
+                ~Lock() noexcept {
+                    pthread_mutex_unlock(mutex);
+                }
+
+        };
+
+        std::optional<timespec> toDeadline(uint32_t timeout) {
+            if (timeout == 0) {
+                return {};
+            }
+            timespec result = {};
+            clock_gettime(CLOCK_MONOTONIC, &result);
+            result.tv_sec += timeout / 1000;
+            result.tv_nsec += (long) (timeout % 1000) * 1000000;
+            if (result.tv_nsec >= 1000000000) {
+                result.tv_sec++;
+                result.tv_nsec -= 1000000000;
+            }
+            return result;
+        }
+
+        /*!
+        * @return 'false' once 'deadline' passed.
+        */
+        bool wait(Header& header, const std::optional<timespec>& deadline) {
+            int result = deadline ? pthread_cond_timedwait(&header.condition, &header.mutex, &deadline.value()) : pthread_cond_wait(&header.condition, &header.mutex);
+            if (result == EOWNERDEAD) {
+                pthread_mutex_consistent(&header.mutex);
+            } else if (result == ETIMEDOUT) {
+                return false;
+            } else if (result != 0) {
+                throw std::runtime_error(CALL_INFO + ": pthread_cond_wait: " + std::string(std::strerror(result)));
+            }
+            return true;
+        }
+
+        void* map(const std::string& name, int flags, size_t size, size_t* mappedSize) {
+            int file = shm_open(name.c_str(), flags, 0600);
+            if (file < 0) {
+                throw std::runtime_error(CALL_INFO + ": shm_open: '" + name + "': " + std::string(std::strerror(errno)));
+            }
+            if (flags & O_CREAT) {
+                if (ftruncate(file, (off_t) size) != 0) {
+                    int error = errno;
+                    ::close(file);
+                    shm_unlink(name.c_str());
+                    throw std::runtime_error(CALL_INFO + ": ftruncate: '" + name + "': " + std::string(std::strerror(error)));
+                }
+            } else {
+                struct stat status = {};
+                if (fstat(file, &status) != 0 || (size_t) status.st_size < DATA_OFFSET) {
+                    ::close(file);
+                    throw std::runtime_error(CALL_INFO + ": '" + name + "' is not a ring");
+                }
+                size = (size_t) status.st_size;
+            }
+            void* result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            ::close(file);
+            if (result == MAP_FAILED) {
+                throw std::runtime_error(CALL_INFO + ": mmap: '" + name + "': " + std::string(std::strerror(errno)));
+            }
+            *mappedSize = size;
+            return result;
+        }
+
+    }
+
+    SharedMemoryRing::SharedMemoryRing(const std::string& name, size_t capacity): name(name), owner(true) {
+        try {
+            capacity = (capacity + 7) / 8 * 8;
+            if (capacity < 64) {
+                throw std::runtime_error(CALL_INFO + ": capacity: " + std::to_string(capacity) + " less 64");
+            }
+            shm_unlink(name.c_str());
+            memory = map(name, O_RDWR | O_CREAT | O_EXCL, DATA_OFFSET + capacity, &mappedSize);
+
+            Header& header = toHeader(memory);
+            header.version = VERSION;
+            header.closed = 0;
+            header.capacity = capacity;
+            header.head = 0;
+            header.tail = 0;
+            header.metadataSize = 0;
+            header.process = (uint64_t) getpid();
+
+            pthread_mutexattr_t mutexAttributes;
+            pthread_mutexattr_init(&mutexAttributes);
+            pthread_mutexattr_setpshared(&mutexAttributes, PTHREAD_PROCESS_SHARED);
+            pthread_mutexattr_setrobust(&mutexAttributes, PTHREAD_MUTEX_ROBUST);
+            pthread_mutex_init(&header.mutex, &mutexAttributes);
+            pthread_mutexattr_destroy(&mutexAttributes);
+
+            pthread_condattr_t conditionAttributes;
+            pthread_condattr_init(&conditionAttributes);
+            pthread_condattr_setpshared(&conditionAttributes, PTHREAD_PROCESS_SHARED);
+            pthread_condattr_setclock(&conditionAttributes, CLOCK_MONOTONIC);
+            pthread_cond_init(&header.condition, &conditionAttributes);
+            pthread_condattr_destroy(&conditionAttributes);
+
+            // the magic is written last, attaching processes reject a ring that is still initialized
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    SharedMemoryRing::SharedMemoryRing(const std::string& name): name(name), owner(false) {
+        try {
+            memory = map(name, O_RDWR, 0, &mappedSize);
+            Header& header = toHeader(memory);
+            bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (!valid || header.version != VERSION || DATA_OFFSET + header.capacity > mappedSize) {
+                munmap(memory, mappedSize);
+                memory = nullptr;
+                throw std::runtime_error(CALL_INFO + ": '" + name + "' is not a ring or not ready");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string SharedMemoryRing::getName() {
+        try {
+            return name;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t SharedMemoryRing::getCapacity() {
+        try {
+            return toHeader(memory).capacity;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t SharedMemoryRing::getMaxRecordSize() {
+        try {
+            return toHeader(memory).capacity / 2 - sizeof(RecordHeader);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryRing::setMetadata(const std::string& value) {
+        try {
+            if (value.size() > METADATA_CAPACITY) {
+                throw std::runtime_error(CALL_INFO + ": value size: " + std::to_string(value.size()) + " greater " + std::to_string(METADATA_CAPACITY));
+            }
+            Header& header = toHeader(memory);
+            Lock lock(header);
+            std::memcpy(header.metadata, value.data(), value.size());
+            header.metadataSize = value.size();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string SharedMemoryRing::getMetadata() {
+        try {
+            Header& header = toHeader(memory);
+            Lock lock(header);
+            return {header.metadata, std::min<size_t>(header.metadataSize, METADATA_CAPACITY)};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SharedMemoryRing::push(const uint8_t* data, size_t size, uint32_t tag, uint32_t timeout) {
+        try {
+            if (size > getMaxRecordSize()) {
+                throw std::runtime_error(CALL_INFO + ": size: " + std::to_string(size) + " greater " + std::to_string(getMaxRecordSize()));
+            }
+            Header& header = toHeader(memory);
+            std::optional<timespec> deadline = toDeadline(timeout);
+            size_t length = toLength(size);
+            Lock lock(header);
+            uint64_t padding = 0;
+            while (true) {
+                if (header.closed) {
+                    return false;
+                }
+                uint64_t free = header.capacity - header.tail % header.capacity;
+                padding = free < length ? free : 0;
+                if (header.tail + padding + length - header.head <= header.capacity) {
+                    break;
+                }
+                if (!wait(header, deadline)) {
+                    return false;
+                }
+            }
+            if (padding > 0) {
+                toRecord(memory, header.tail) = {PADDING, 0};
+                header.tail += padding;
+            }
+            RecordHeader& record = toRecord(memory, header.tail);
+            record = {(uint32_t) size, tag};
+            std::memcpy(&record + 1, data, size);
+            header.tail += length;
+            pthread_cond_broadcast(&header.condition);
+            return true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<SharedMemoryRing::Record> SharedMemoryRing::pop(uint8_t* data, size_t capacity, uint32_t timeout) {
+        try {
+            Header& header = toHeader(memory);
+            std::optional<timespec> deadline = toDeadline(timeout);
+            Lock lock(header);
+            while (true) {
+                header.head = skipPadding(memory, header.head, header.tail);
+                if (header.head < header.tail) {
+                    break;
+                }
+                if (header.closed || !wait(header, deadline)) {
+                    return {};
+                }
+            }
+            RecordHeader& record = toRecord(memory, header.head);
+            Record result = {};
+            result.size = std::min<size_t>(record.size, capacity);
+            result.tag = record.tag;
+            result.truncated = record.size > capacity;
+            std::memcpy(data, &record + 1, result.size);
+            header.head += toLength(record.size);
+            pthread_cond_broadcast(&header.condition);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint8_t* SharedMemoryRing::reserve(size_t size) {
+        try {
+            if (size > getMaxRecordSize()) {
+                throw std::runtime_error(CALL_INFO + ": size: " + std::to_string(size) + " greater " + std::to_string(getMaxRecordSize()));
+            }
+            Header& header = toHeader(memory);
+            size_t length = toLength(size);
+            Lock lock(header);
+            uint64_t free = header.capacity - header.tail % header.capacity;
+            uint64_t padding = free < length ? free : 0;
+            uint64_t end = header.tail + padding + length;
+            // readers copy under the lock and check 'head' first, so the reserved bytes can be filled without it
+            while (end - header.head > header.capacity) {
+                RecordHeader& oldest = toRecord(memory, header.head);
+                header.head += oldest.size == PADDING ? header.capacity - header.head % header.capacity : toLength(oldest.size);
+            }
+            if (padding > 0) {
+                toRecord(memory, header.tail) = {PADDING, 0};
+            }
+            reserved = header.tail + padding;
+            reservedSize = size;
+            return reinterpret_cast<uint8_t*>(&toRecord(memory, reserved) + 1);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryRing::commit(size_t size, uint32_t tag) {
+        try {
+            if (size > reservedSize) {
+                throw std::runtime_error(CALL_INFO + ": size: " + std::to_string(size) + " greater reserved: " + std::to_string(reservedSize));
+            }
+            Header& header = toHeader(memory);
+            Lock lock(header);
+            if (size > 0) {
+                toRecord(memory, reserved) = {(uint32_t) size, tag};
+                header.tail = reserved + toLength(size);
+            } else {
+                header.tail = std::max(header.tail, reserved);
+            }
+            reservedSize = 0;
+            pthread_cond_broadcast(&header.condition);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint64_t SharedMemoryRing::getTail() {
+        try {
+            Header& header = toHeader(memory);
+            Lock lock(header);
+            return header.tail;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<SharedMemoryRing::Record> SharedMemoryRing::read(uint64_t& cursor, uint8_t* data, size_t capacity, uint32_t timeout) {
+        try {
+            Header& header = toHeader(memory);
+            std::optional<timespec> deadline = toDeadline(timeout);
+            Record result = {};
+            Lock lock(header);
+            while (true) {
+                if (cursor < header.head) {
+                    cursor = header.head;
+                    result.overrun = true;
+                }
+                cursor = skipPadding(memory, cursor, header.tail);
+                if (cursor < header.tail) {
+                    break;
+                }
+                if (header.closed || !wait(header, deadline)) {
+                    return {};
+                }
+            }
+            RecordHeader& record = toRecord(memory, cursor);
+            result.size = std::min<size_t>(record.size, capacity);
+            result.tag = record.tag;
+            result.truncated = record.size > capacity;
+            std::memcpy(data, &record + 1, result.size);
+            cursor += toLength(record.size);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SharedMemoryRing::isOwnerAlive() {
+        try {
+            // written once before the magic, no lock needed
+            pid_t process = (pid_t) toHeader(memory).process;
+            return kill(process, 0) == 0 || errno == EPERM;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryRing::close() {
+        try {
+            Header& header = toHeader(memory);
+            Lock lock(header);
+            header.closed = 1;
+            pthread_cond_broadcast(&header.condition);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SharedMemoryRing::isClosed() {
+        try {
+            Header& header = toHeader(memory);
+            Lock lock(header);
+            return header.closed != 0;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    SharedMemoryRing::~SharedMemoryRing() noexcept {
+        if (memory == nullptr) {
+            return;
+        }
+        if (owner) {
+            try {
+                close();
+            } catch (...) {
+            }
+            shm_unlink(name.c_str());
+        }
+        munmap(memory, mappedSize);
+    }
+
+#else
+
+    SharedMemoryRing::SharedMemoryRing(const std::string& name, size_t capacity): name(name), owner(true) {
+        throw std::runtime_error(CALL_INFO + ": not supported on this platform");
+    }
+
+    SharedMemoryRing::SharedMemoryRing(const std::string& name): name(name) {
+        throw std::runtime_error(CALL_INFO + ": not supported on this platform");
+    }
+
+    std::string SharedMemoryRing::getName() { return name; }
+    size_t SharedMemoryRing::getCapacity() { return 0; }
+    size_t SharedMemoryRing::getMaxRecordSize() { return 0; }
+    void SharedMemoryRing::setMetadata(const std::string& value) {}
+    std::string SharedMemoryRing::getMetadata() { return {}; }
+    bool SharedMemoryRing::push(const uint8_t* data, size_t size, uint32_t tag, uint32_t timeout) { return false; }
+    std::optional<SharedMemoryRing::Record> SharedMemoryRing::pop(uint8_t* data, size_t capacity, uint32_t timeout) { return {}; }
+    uint8_t* SharedMemoryRing::reserve(size_t size) { return nullptr; }
+    void SharedMemoryRing::commit(size_t size, uint32_t tag) {}
+    uint64_t SharedMemoryRing::getTail() { return 0; }
+    std::optional<SharedMemoryRing::Record> SharedMemoryRing::read(uint64_t& cursor, uint8_t* data, size_t capacity, uint32_t timeout) { return {}; }
+    bool SharedMemoryRing::isOwnerAlive() { return false; }
+    void SharedMemoryRing::close() {}
+    bool SharedMemoryRing::isClosed() { return true; }
+    SharedMemoryRing::~SharedMemoryRing() noexcept = default;
+
+#endif
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <optional>
+
+#include "exqudens/usb/export.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Ring of variable size records in POSIX shared memory, synchronized by a process-shared robust mutex.
+    * Used two ways:
+    * - queue: many processes 'push', one process 'pop's, 'push' waits while the ring is full;
+    * - broadcast: one process 'reserve's and 'commit's (fills the record in place, e.g. by a bulk read), any number of
+    *   processes 'read' with their own cursor, the writer never waits and overwrites the oldest records.
+    * Linux only, other platforms throw from the constructors.
+    */
+    class EXQUDENS_USB_EXPORT SharedMemoryRing {
+
+        public:
+
+            inline static const size_t METADATA_CAPACITY = 1024;
+
+            struct Record {
+                size_t size = 0; //!< Bytes copied.
+                uint32_t tag = 0; //!< Set by the writer, e.g. an endpoint address.
+                bool truncated = false; //!< The record did not fit into the read buffer, the rest is dropped.
+                bool overrun = false; //!< 'read' only, records were overwritten before this cursor reached them.
+            };
+
+        private:
+
+            std::string name = {};
+            bool owner = false;
+            void* memory = nullptr;
+            size_t mappedSize = 0;
+            uint64_t reserved = 0; //!< Start of the record reserved by 'reserve'.
+            size_t reservedSize = 0;
+
+        public:
+
+            /*!
+            * Creates the ring, a stale ring of the same name is replaced. The ring is unlinked on destruction.
+            *
+            * @throws std::runtime_error
+            */
+            SharedMemoryRing(
+                const std::string& name, //!< Shared memory object name, e.g. '/exqudens-usb-device1-out'.
+                size_t capacity //!< Data bytes, rounded up to a multiple of 8. Records may use up to half of it.
+            );
+
+            /*!
+            * Maps an existing ring.
+            *
+            * @throws std::runtime_error
+            */
+            explicit SharedMemoryRing(const std::string& name);
+
+            SharedMemoryRing(const SharedMemoryRing& other) = delete;
+
+            SharedMemoryRing& operator=(const SharedMemoryRing& other) = delete;
+
+            std::string getName();
+
+            size_t getCapacity();
+
+            size_t getMaxRecordSize();
+
+            void setMetadata(const std::string& value);
+
+            std::string getMetadata();
+
+            /*!
+            * Queue: appends a record, waits up to 'timeout' milliseconds ('0' for unlimited) for free space.
+            *
+            * @return 'false' on timeout or if the ring is closed.
+            */
+            bool push(const uint8_t* data, size_t size, uint32_t tag, uint32_t timeout);
+
+            /*!
+            * Queue: removes the oldest record, waits up to 'timeout' milliseconds ('0' for unlimited).
+            *
+            * @return Empty on timeout or if the ring is closed and empty.
+            */
+            std::optional<Record> pop(uint8_t* data, size_t capacity, uint32_t timeout);
+
+            /*!
+            * Broadcast: reserves a record of up to 'size' bytes, overwriting the oldest records.
+            * The writer fills the returned memory and publishes it with 'commit'. One writer at a time.
+            */
+            uint8_t* reserve(size_t size);
+
+            /*!
+            * Broadcast: publishes the first 'size' bytes of the reserved record to the readers, '0' drops it.
+            */
+            void commit(size_t size, uint32_t tag);
+
+            /*!
+            * Broadcast: position after the newest record, a reader starting here gets only new records.
+            */
+            uint64_t getTail();
+
+            /*!
+            * Broadcast: copies the record at 'cursor' and moves the cursor past it, waits up to 'timeout' milliseconds ('0' for unlimited).
+            * A cursor behind the oldest record skips to it and the result is flagged 'overrun'.
+            *
+            * @return Empty on timeout or if the ring is closed and the cursor is at the tail.
+            */
+            std::optional<Record> read(uint64_t& cursor, uint8_t* data, size_t capacity, uint32_t timeout);
+
+            /*!
+            * @return 'false' once the process that created the ring exited without closing it, e.g. crashed.
+            */
+            bool isOwnerAlive();
+
+            /*!
+            * Wakes every waiting process, later 'push' fails and reads drain the remaining records.
+            */
+            void close();
+
+            bool isClosed();
+
+            ~SharedMemoryRing() noexcept;
+
+    };
+
+}
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+
+#include "exqudens/usb/SharedMemoryServer.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    std::string SharedMemoryServer::toInName(const std::string& name, uint8_t endpoint) {
+        try {
+            std::ostringstream out;
+            out << name << "-in-" << std::hex << std::setw(2) << std::setfill('0') << (int) endpoint;
+            return out.str();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string SharedMemoryServer::toOutName(const std::string& name) {
+        try {
+            return name + "-out";
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    SharedMemoryServer::SharedMemoryServer(
+        const std::shared_ptr<IClient>& client,
+        const std::string& name,
+        const Options& options
+    ):
+        client(client),
+        name(name),
+        options(options)
+    {
+        try {
+            if (!this->client) {
+                throw std::runtime_error(CALL_INFO + ": client is null!");
+            }
+            if (name.empty()) {
+                throw std::runtime_error(CALL_INFO + ": name is empty!");
+            }
+            if (options.readSize == 0 || options.readSize > options.inCapacity / 2 - 8) {
+                throw std::runtime_error(CALL_INFO + ": readSize: " + std::to_string(options.readSize) + " must be greater zero and fit half of inCapacity!");
+            }
+            for (uint8_t endpoint : options.inEndpoints) {
+                if (!(endpoint & 0x80)) {
+                    throw std::runtime_error(CALL_INFO + ": endpoint: " + std::to_string(endpoint) + " is not an IN endpoint!");
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    SharedMemoryServer::SharedMemoryServer(const std::shared_ptr<IClient>& client, const std::string& name): SharedMemoryServer(client, name, Options()) {}
+
+    std::string SharedMemoryServer::getName() {
+        try {
+            return name;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryServer::start() {
+        try {
+            if (isRunning()) {
+                throw std::runtime_error(CALL_INFO + ": already running! call 'stop' before...");
+            }
+            if (!client->isOpen()) {
+                throw std::runtime_error(CALL_INFO + ": the device is not open! call 'open' before...");
+            }
+            inRings.clear();
+            for (uint8_t endpoint : options.inEndpoints) {
+                inRings[endpoint] = std::make_unique<SharedMemoryRing>(toInName(name, endpoint), options.inCapacity);
+            }
+            // created last, clients attach to the queue ring first and find every IN ring in place
+            outRing = std::make_unique<SharedMemoryRing>(toOutName(name), options.outCapacity);
+            outRing->setMetadata(toMetadata());
+            bytesRead = 0;
+            readCount = 0;
+            bytesWritten = 0;
+            writeCount = 0;
+            writeErrors = 0;
+            error = nullptr;
+            token = std::make_shared<CancellationToken>();
+            for (auto& [endpoint, ring] : inRings) {
+                threads.emplace_back(&SharedMemoryServer::read, this, endpoint, std::ref(*ring));
+            }
+            threads.emplace_back(&SharedMemoryServer::write, this);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SharedMemoryServer::isRunning() {
+        try {
+            return !threads.empty();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryServer::stop() {
+        try {
+            if (!isRunning()) {
+                return;
+            }
+            token->cancel();
+            // the writer drains the queued messages and returns once the closed queue is empty
+            outRing->close();
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            threads.clear();
+            inRings.clear();
+            outRing.reset();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::exception_ptr SharedMemoryServer::getError() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return error;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    SharedMemoryServer::Stats SharedMemoryServer::getStats() {
+        try {
+            Stats result = {};
+            result.bytesRead = bytesRead;
+            result.readCount = readCount;
+            result.bytesWritten = bytesWritten;
+            result.writeCount = writeCount;
+            result.writeErrors = writeErrors;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    SharedMemoryServer::~SharedMemoryServer() noexcept {
+        try {
+            stop();
+        } catch (...) {
+        }
+    }
+
+    void SharedMemoryServer::read(uint8_t endpoint, SharedMemoryRing& ring) {
+        try {
+            while (true) {
+                // the device writes straight into the reserved record, the clients copy it out once
+                Buffer buffer(ring.reserve(options.readSize), options.readSize, false, {});
+                size_t size = 0;
+                try {
+                    size = client->bulkRead(buffer, endpoint, std::chrono::steady_clock::time_point::max(), token);
+                } catch (...) {
+                    ring.commit(0, endpoint);
+                    if (token->isCancelled()) {
+                        break;
+                    }
+                    throw;
+                }
+                ring.commit(size, endpoint);
+                bytesRead += size;
+                readCount++;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        ring.close();
+    }
+
+    void SharedMemoryServer::write() {
+        try {
+            std::vector<uint8_t> data(outRing->getMaxRecordSize());
+            while (true) {
+                std::optional<SharedMemoryRing::Record> record = outRing->pop(data.data(), data.size(), 0);
+                if (!record) {
+                    break;
+                }
+                try {
+                    Buffer buffer(data.data(), record->size, false, {});
+                    buffer.setSize(record->size);
+                    bytesWritten += client->bulkWrite(buffer, (uint8_t) record->tag, options.writeTimeout, false);
+                    writeCount++;
+                } catch (...) {
+                    writeErrors++;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    std::string SharedMemoryServer::toMetadata() {
+        try {
+            std::map<std::string, uint16_t> device = client->getDevice();
+            std::ostringstream out;
+            for (const auto& [key, value] : device) {
+                out << key << "=" << value << "\n";
+            }
+            std::map<std::string, StringDescriptor> strings = {
+                {"manufacturer", StringDescriptor::MANUFACTURER},
+                {"productName", StringDescriptor::PRODUCT},
+                {"serial", StringDescriptor::SERIAL_NUMBER}
+            };
+            for (const auto& [key, type] : strings) {
+                std::string value = client->getStringDescriptor(device, type).value_or("");
+                std::replace(value.begin(), value.end(), '\n', ' ');
+                out << key << "=" << value << "\n";
+            }
+            out << "inEndpoints=";
+            for (uint8_t endpoint : options.inEndpoints) {
+                out << (endpoint == *options.inEndpoints.begin() ? "" : ",") << (int) endpoint;
+            }
+            out << "\n";
+            out << "readSize=" << options.readSize << "\n";
+            return out.str();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
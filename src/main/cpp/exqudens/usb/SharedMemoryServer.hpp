@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <set>
+#include <map>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+
+#include "exqudens/usb/IClient.hpp"
+#include "exqudens/usb/SharedMemoryRing.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Daemon side of the shared memory multiplexing, lets many local processes use one claimed device.
+    * A reader thread per IN endpoint reads straight into the broadcast ring 'toInName(name, endpoint)',
+    * every 'SharedMemoryTransport' maps the ring and reads it with its own cursor.
+    * OUT messages are pushed by the clients into the queue ring 'toOutName(name)' tagged with the endpoint,
+    * a writer thread pops and writes them in arrival order. The queue ring also carries the device description.
+    * Linux only.
+    */
+    class EXQUDENS_USB_EXPORT SharedMemoryServer {
+
+        public:
+
+            struct Options {
+                std::set<uint8_t> inEndpoints = {0x81};
+                size_t inCapacity = 4 << 20; //!< Bytes per IN ring, readers further behind than this lose data.
+                size_t outCapacity = 1 << 20; //!< Bytes of queued OUT messages before clients wait.
+                size_t readSize = 16 << 10; //!< Bytes per bulk read, a multiple of the packet size. Clients should read with at least this size.
+                uint32_t writeTimeout = 1000; //!< Milliseconds per queued OUT message.
+            };
+
+            struct Stats {
+                uint64_t bytesRead = 0;
+                uint64_t readCount = 0;
+                uint64_t bytesWritten = 0;
+                uint64_t writeCount = 0;
+                uint64_t writeErrors = 0; //!< Failed OUT messages, the clients are not notified.
+            };
+
+        private:
+
+            std::shared_ptr<IClient> client = nullptr;
+            std::string name = {};
+            Options options = {};
+            std::map<uint8_t, std::unique_ptr<SharedMemoryRing>> inRings = {};
+            std::unique_ptr<SharedMemoryRing> outRing = nullptr;
+            std::shared_ptr<CancellationToken> token = nullptr;
+            std::vector<std::thread> threads = {};
+            std::mutex mutex = {};
+            std::exception_ptr error = nullptr;
+            std::atomic<uint64_t> bytesRead = 0;
+            std::atomic<uint64_t> readCount = 0;
+            std::atomic<uint64_t> bytesWritten = 0;
+            std::atomic<uint64_t> writeCount = 0;
+            std::atomic<uint64_t> writeErrors = 0;
+
+        public:
+
+            /*!
+            * Shared memory object name prefix, e.g. '/exqudens-usb-1-3' gives '/exqudens-usb-1-3-out' and '/exqudens-usb-1-3-in-81'.
+            */
+            static std::string toInName(const std::string& name, uint8_t endpoint);
+
+            static std::string toOutName(const std::string& name);
+
+            SharedMemoryServer(
+                const std::shared_ptr<IClient>& client, //!< Open client, the server does not close it.
+                const std::string& name,
+                const Options& options
+            );
+            SharedMemoryServer(const std::shared_ptr<IClient>& client, const std::string& name);
+            SharedMemoryServer(const SharedMemoryServer& other) = delete;
+
+            SharedMemoryServer& operator=(const SharedMemoryServer& other) = delete;
+
+            std::string getName();
+
+            /*!
+            * Creates the rings, publishes the device description and starts serving.
+            *
+            * @throws std::runtime_error
+            */
+            void start();
+
+            bool isRunning();
+
+            /*!
+            * Cancels the in-flight reads, writes the already queued OUT messages and removes the rings,
+            * clients get 'LIBUSB_ERROR_NO_DEVICE' afterwards.
+            *
+            * @throws std::runtime_error If a reader thread failed.
+            */
+            void stop();
+
+            /*!
+            * @return The failure that ended a reader or the writer thread, 'nullptr' while serving. 'stop' rethrows it.
+            */
+            std::exception_ptr getError();
+
+            Stats getStats();
+
+            ~SharedMemoryServer() noexcept;
+
+        private:
+
+            void read(uint8_t endpoint, SharedMemoryRing& ring);
+
+            void write();
+
+            std::string toMetadata();
+
+    };
+
+}
@@ -0,0 +1,381 @@
+#include <cstring>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <filesystem>
+#include <stdexcept>
+
+#include <libusb.h>
+
+#include "exqudens/usb/SharedMemoryTransport.hpp"
+#include "exqudens/usb/SharedMemoryServer.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    SharedMemoryTransport::SharedMemoryTransport(const std::string& name): name(name) {
+        try {
+            if (name.empty()) {
+                throw std::runtime_error(CALL_INFO + ": name is empty!");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string SharedMemoryTransport::getName() {
+        try {
+            return std::string(NAME);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryTransport::init() {
+        try {
+            initialized = true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SharedMemoryTransport::isInitialized() {
+        try {
+            return initialized;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> SharedMemoryTransport::listDevices() {
+        try {
+            return listDevices(DeviceFilter {});
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> SharedMemoryTransport::listDevices(const DeviceFilter& filter) {
+        try {
+            if (!initialized) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            std::map<std::string, std::string> metadata = readMetadata();
+            if (metadata.empty()) {
+                return {};
+            }
+            std::map<std::string, uint16_t> result = toDevice(metadata);
+            if (filter.bus && filter.bus.value() != result.at("bus")) {
+                return {};
+            }
+            for (size_t i = 0; i < filter.portPath.size(); i++) {
+                std::string key = "portPath" + std::to_string(i);
+                if (!result.contains(key) || result.at(key) != filter.portPath.at(i)) {
+                    return {};
+                }
+            }
+            if (!filter.vendors.empty() && !filter.vendors.contains(result.at("vendor"))) {
+                return {};
+            }
+            if (!filter.products.empty() && !filter.products.contains(result.at("product"))) {
+                return {};
+            }
+            // the device class is not published
+            if (filter.deviceClass) {
+                return {};
+            }
+            if (filter.serial && filter.serial.value() != metadata["serial"]) {
+                return {};
+            }
+            return {result};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::string> SharedMemoryTransport::getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) {
+        try {
+            if (!initialized) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            std::map<std::string, std::string> metadata = readMetadata();
+            if (metadata.empty() || !matches(device, toDevice(metadata))) {
+                throw std::runtime_error(CALL_INFO + ": device is not attached!");
+            }
+            std::string key = type == StringDescriptor::MANUFACTURER ? "manufacturer" : type == StringDescriptor::PRODUCT ? "productName" : "serial";
+            if (metadata[key].empty()) {
+                return {};
+            }
+            return metadata[key];
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryTransport::open(const std::map<std::string, uint16_t>& value, int32_t, const std::optional<bool>&) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!device.empty()) {
+                throw std::runtime_error(CALL_INFO + ": the device is already open! call 'close' before...");
+            }
+            std::map<std::string, std::string> metadata = readMetadata();
+            if (metadata.empty() || !matches(value, toDevice(metadata))) {
+                const char* libusbErrorName = libusb_error_name(LIBUSB_ERROR_NO_DEVICE);
+                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+            // the interface is claimed by the server, 'interfaceNumber' and 'detachKernelDriver' do not apply
+            std::shared_ptr<Connection> result = std::make_shared<Connection>();
+            result->outRing = std::make_unique<SharedMemoryRing>(SharedMemoryServer::toOutName(name));
+            std::istringstream endpoints(metadata["inEndpoints"]);
+            std::string endpoint = {};
+            while (std::getline(endpoints, endpoint, ',')) {
+                std::unique_ptr<Reader> reader = std::make_unique<Reader>();
+                reader->ring = std::make_unique<SharedMemoryRing>(SharedMemoryServer::toInName(name, (uint8_t) std::stoi(endpoint)));
+                reader->cursor = reader->ring->getTail();
+                result->readers[(uint8_t) std::stoi(endpoint)] = std::move(reader);
+            }
+            overrunCount = 0;
+            connection = result;
+            device = value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SharedMemoryTransport::isOpen() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return !device.empty();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> SharedMemoryTransport::waitForDevice(const std::map<std::string, uint16_t>& value, uint32_t timeout) {
+        try {
+            if (!initialized) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            // a restarted server is only visible by its rings, so the wait polls
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            while (true) {
+                for (const std::map<std::string, uint16_t>& entry : listDevices()) {
+                    bool same = true;
+                    for (const char* key : {"vendor", "product", "bus", "port"}) {
+                        same = same && value.contains(key) && value.at(key) == entry.at(key);
+                    }
+                    if (same) {
+                        return entry;
+                    }
+                }
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return {};
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Buffer SharedMemoryTransport::allocateBuffer(size_t capacity) {
+        try {
+            if (!isOpen()) {
+                throw std::runtime_error(CALL_INFO + ": the device is not open! call 'open' before...");
+            }
+            return Buffer(
+                new uint8_t[capacity],
+                capacity,
+                false,
+                [](uint8_t* data, size_t, bool) {
+                    delete[] data;
+                }
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    int SharedMemoryTransport::bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            *transferred = 0;
+            std::shared_ptr<Connection> current = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                current = connection;
+            }
+            if (!current || current->outRing->isClosed()) {
+                return LIBUSB_ERROR_NO_DEVICE;
+            }
+            SharedMemoryRing& outRing = *current->outRing;
+            if (length < 0) {
+                return LIBUSB_ERROR_INVALID_PARAM;
+            }
+            if (token && token->isCancelled()) {
+                return LIBUSB_ERROR_INTERRUPTED;
+            }
+
+            if (!(endpoint & LIBUSB_ENDPOINT_IN)) {
+                if ((size_t) length > outRing.getMaxRecordSize()) {
+                    return LIBUSB_ERROR_INVALID_PARAM;
+                }
+                // a full ring waits for the server, the wait is sliced to notice a crashed one
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+                while (!outRing.push(data, (size_t) length, endpoint, toSlice(timeout, deadline))) {
+                    if (current->closed || outRing.isClosed() || !outRing.isOwnerAlive()) {
+                        return LIBUSB_ERROR_NO_DEVICE;
+                    }
+                    if (timeout > 0 && std::chrono::steady_clock::now() >= deadline) {
+                        return LIBUSB_ERROR_TIMEOUT;
+                    }
+                }
+                *transferred = length;
+                return LIBUSB_SUCCESS;
+            }
+
+            if (!current->readers.contains(endpoint)) {
+                return LIBUSB_ERROR_NOT_FOUND;
+            }
+            Reader& reader = *current->readers.at(endpoint);
+            std::lock_guard<std::mutex> lock(reader.mutex);
+            // the ring condition is process-shared and can not be woken by the token or a crashed server, the wait is sliced instead
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            std::optional<SharedMemoryRing::Record> record = {};
+            while (!record) {
+                if (timeout > 0 && std::chrono::steady_clock::now() >= deadline) {
+                    return LIBUSB_ERROR_TIMEOUT;
+                }
+                record = reader.ring->read(reader.cursor, data, (size_t) length, toSlice(timeout, deadline));
+                if (!record && (current->closed || reader.ring->isClosed() || !reader.ring->isOwnerAlive())) {
+                    return LIBUSB_ERROR_NO_DEVICE;
+                }
+                if (!record && token && token->isCancelled()) {
+                    return LIBUSB_ERROR_INTERRUPTED;
+                }
+            }
+            if (record->overrun) {
+                overrunCount++;
+            }
+            *transferred = (int32_t) record->size;
+            return record->truncated ? LIBUSB_ERROR_OVERFLOW : LIBUSB_SUCCESS;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryTransport::setSpinBudget(uint32_t value) {
+        try {
+            spinBudget = value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint32_t SharedMemoryTransport::getSpinBudget() {
+        try {
+            return spinBudget;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    ITransport::PollStats SharedMemoryTransport::getPollStats() {
+        try {
+            return {};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryTransport::close() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            // the rings are unmapped once the last transfer still holding the connection returns
+            if (connection) {
+                connection->closed = true;
+            }
+            connection = nullptr;
+            device = {};
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SharedMemoryTransport::destroy() {
+        try {
+            initialized = false;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint64_t SharedMemoryTransport::getOverrunCount() {
+        try {
+            return overrunCount;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, std::string> SharedMemoryTransport::readMetadata() {
+        try {
+            std::string value = {};
+            try {
+                SharedMemoryRing ring(SharedMemoryServer::toOutName(name));
+                if (ring.isClosed() || !ring.isOwnerAlive()) {
+                    return {};
+                }
+                value = ring.getMetadata();
+            } catch (...) {
+                return {};
+            }
+            std::map<std::string, std::string> result = {};
+            std::istringstream lines(value);
+            std::string line = {};
+            while (std::getline(lines, line)) {
+                size_t separator = line.find('=');
+                if (separator != std::string::npos) {
+                    result[line.substr(0, separator)] = line.substr(separator + 1);
+                }
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint32_t SharedMemoryTransport::toSlice(uint32_t timeout, const std::chrono::steady_clock::time_point& deadline) {
+        try {
+            uint32_t result = 10;
+            if (timeout > 0) {
+                int64_t remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                result = (uint32_t) std::clamp<int64_t>(remaining, 1, result);
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> SharedMemoryTransport::toDevice(const std::map<std::string, std::string>& metadata) {
+        try {
+            std::map<std::string, uint16_t> result = {};
+            for (const char* key : {"vendor", "product", "port", "bus", "address"}) {
+                if (!metadata.contains(key)) {
+                    throw std::runtime_error(CALL_INFO + ": metadata has no: '" + std::string(key) + "'");
+                }
+                result[key] = (uint16_t) std::stoul(metadata.at(key));
+            }
+            for (size_t i = 0; metadata.contains("portPath" + std::to_string(i)); i++) {
+                result["portPath" + std::to_string(i)] = (uint16_t) std::stoul(metadata.at("portPath" + std::to_string(i)));
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
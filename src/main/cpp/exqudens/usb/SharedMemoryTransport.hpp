@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "exqudens/usb/ITransport.hpp"
+#include "exqudens/usb/SharedMemoryRing.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Client side of the shared memory multiplexing, the device is owned by a 'SharedMemoryServer' of the same name.
+    * Lists the one served device and opens it without claiming anything, so any number of processes can open it at once.
+    * Every IN endpoint is read with its own cursor starting at 'open', so each client sees every record received after it.
+    * OUT transfers complete once queued to the server, device errors on write are only counted by the server.
+    * A server that exited without closing its rings (e.g. crashed) is treated as a detached device.
+    * Linux only.
+    */
+    class EXQUDENS_USB_EXPORT SharedMemoryTransport: public virtual ITransport {
+
+        public:
+
+            inline static const char* NAME = "shared-memory";
+
+        private:
+
+            struct Reader {
+                std::unique_ptr<SharedMemoryRing> ring = nullptr;
+                uint64_t cursor = 0;
+                std::mutex mutex = {};
+            };
+
+            /*!
+            * Rings of one 'open', a transfer keeps its copy alive so 'close' never frees the rings under it.
+            */
+            struct Connection {
+                std::unique_ptr<SharedMemoryRing> outRing = nullptr;
+                std::map<uint8_t, std::unique_ptr<Reader>> readers = {};
+                std::atomic<bool> closed = false; //!< Set by 'close', ends the waits of transfers still holding the connection.
+            };
+
+            std::string name = {};
+            bool initialized = false;
+            std::mutex mutex = {}; //!< Guards 'device' and 'connection'.
+            std::map<std::string, uint16_t> device = {};
+            std::shared_ptr<Connection> connection = nullptr;
+            std::atomic<uint32_t> spinBudget = 0;
+            std::atomic<uint64_t> overrunCount = 0;
+
+        public:
+
+            explicit SharedMemoryTransport(
+                const std::string& name //!< 'SharedMemoryServer' name.
+            );
+
+            std::string getName() override;
+
+            void init() override;
+
+            bool isInitialized() override;
+
+            std::vector<std::map<std::string, uint16_t>> listDevices() override;
+            std::vector<std::map<std::string, uint16_t>> listDevices(const DeviceFilter& filter) override;
+
+            std::optional<std::string> getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) override;
+
+            void open(const std::map<std::string, uint16_t>& value, int32_t interfaceNumber, const std::optional<bool>& detachKernelDriver) override;
+
+            bool isOpen() override;
+
+            std::map<std::string, uint16_t> waitForDevice(const std::map<std::string, uint16_t>& value, uint32_t timeout) override;
+
+            Buffer allocateBuffer(size_t capacity) override;
+
+            /*!
+            * A read shorter than the received record fails with 'LIBUSB_ERROR_OVERFLOW', read with at least the server 'readSize'.
+            */
+            int bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) override;
+
+            /*!
+            * Stored only, reads always wait on the ring.
+            */
+            void setSpinBudget(uint32_t value) override;
+
+            uint32_t getSpinBudget() override;
+
+            PollStats getPollStats() override;
+
+            void close() override;
+
+            void destroy() override;
+
+            /*!
+            * Reads that found their records already overwritten by the server, the client reads slower than the device sends.
+            */
+            uint64_t getOverrunCount();
+
+            ~SharedMemoryTransport() noexcept override = default;
+
+        private:
+
+            /*!
+            * @return The device description published by the server, empty if no server runs.
+            */
+            std::map<std::string, std::string> readMetadata();
+
+            /*!
+            * @return Milliseconds of the next ring wait, short enough to check for a closed or crashed server.
+            */
+            static uint32_t toSlice(uint32_t timeout, const std::chrono::steady_clock::time_point& deadline);
+
+            std::map<std::string, uint16_t> toDevice(const std::map<std::string, std::string>& metadata);
+
+    };
+
+}
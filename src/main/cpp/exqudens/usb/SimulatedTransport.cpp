@@ -0,0 +1,449 @@
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <filesystem>
+#include <stdexcept>
+
+#include <libusb.h>
+
+#include "exqudens/usb/SimulatedTransport.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    SimulatedTransport::SimulatedTransport(const Options& options): options(options) {
+        for (size_t i = 0; i < options.deviceCount; i++) {
+            addresses.emplace_back((uint16_t) (i + 1));
+        }
+        nextAddress = (uint16_t) (options.deviceCount + 1);
+    }
+
+    SimulatedTransport::SimulatedTransport(): SimulatedTransport(Options {}) {}
+
+    SimulatedTransport::Options SimulatedTransport::getOptions() {
+        try {
+            return options;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string SimulatedTransport::getName() {
+        try {
+            return std::string(NAME);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::init() {
+        try {
+            initialized = true;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SimulatedTransport::isInitialized() {
+        try {
+            return initialized;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> SimulatedTransport::listDevices() {
+        try {
+            if (!initialized) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            return toDevices();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> SimulatedTransport::listDevices(const DeviceFilter& filter) {
+        try {
+            if (!initialized) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            std::vector<std::map<std::string, uint16_t>> result = {};
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < options.deviceCount; i++) {
+                // every simulated device sits on root port 'i + 1' of bus 1
+                if (disconnected.contains(i)) {
+                    continue;
+                }
+                if (filter.bus && filter.bus.value() != 1) {
+                    continue;
+                }
+                if (!filter.portPath.empty() && (filter.portPath.size() > 1 || filter.portPath.front() != i + 1)) {
+                    continue;
+                }
+                if (!filter.vendors.empty() && !filter.vendors.contains(options.vendor)) {
+                    continue;
+                }
+                if (!filter.products.empty() && !filter.products.contains(options.product)) {
+                    continue;
+                }
+                if (filter.deviceClass && filter.deviceClass.value() != options.deviceClass) {
+                    continue;
+                }
+                if (filter.serial && filter.serial.value() != options.serialPrefix + std::to_string(i + 1)) {
+                    continue;
+                }
+                result.emplace_back(toMap(i));
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::optional<std::string> SimulatedTransport::getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) {
+        try {
+            if (!initialized) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < options.deviceCount; i++) {
+                if (disconnected.contains(i) || !matches(device, toMap(i))) {
+                    continue;
+                }
+                if (type == StringDescriptor::MANUFACTURER) {
+                    return options.manufacturer;
+                } else if (type == StringDescriptor::PRODUCT) {
+                    return options.productName;
+                } else {
+                    return options.serialPrefix + std::to_string(i + 1);
+                }
+            }
+            throw std::runtime_error(CALL_INFO + ": device is not attached!");
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::open(const std::map<std::string, uint16_t>& value, int32_t interfaceNumber, const std::optional<bool>&) {
+        try {
+            if (isOpen()) {
+                throw std::runtime_error(CALL_INFO + ": the device is already open! call 'close' before...");
+            }
+            std::vector<std::map<std::string, uint16_t>> devices = listDevices();
+            if (std::ranges::none_of(devices, [&value](const std::map<std::string, uint16_t>& entry) { return matches(value, entry); })) {
+                const char* libusbErrorName = libusb_error_name(LIBUSB_ERROR_NO_DEVICE);
+                throw std::runtime_error(CALL_INFO + ": libusbErrorName: '" + std::string(libusbErrorName) + "'");
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            queues.clear();
+            for (uint8_t endpoint : options.endpoints) {
+                if (endpoint & LIBUSB_ENDPOINT_IN) {
+                    queues[endpoint] = {};
+                }
+            }
+            this->interfaceNumber = interfaceNumber;
+            lost = false;
+            generation++;
+            device = value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool SimulatedTransport::isOpen() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            return !device.empty();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> SimulatedTransport::waitForDevice(const std::map<std::string, uint16_t>& value, uint32_t timeout) {
+        try {
+            if (!initialized) {
+                throw std::runtime_error(CALL_INFO + ": not initialized! call 'init' before...");
+            }
+            std::map<std::string, uint16_t> result = {};
+            auto found = [this, &value, &result]() {
+                for (const std::map<std::string, uint16_t>& entry : toDevices()) {
+                    bool same = true;
+                    for (const char* key : {"vendor", "product", "bus", "port"}) {
+                        same = same && value.contains(key) && value.at(key) == entry.at(key);
+                    }
+                    if (same) {
+                        result = entry;
+                        return true;
+                    }
+                }
+                return false;
+            };
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait_for(lock, std::chrono::milliseconds(timeout), found);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    Buffer SimulatedTransport::allocateBuffer(size_t capacity) {
+        try {
+            if (!isOpen()) {
+                throw std::runtime_error(CALL_INFO + ": the device is not open! call 'open' before...");
+            }
+            return Buffer(
+                new uint8_t[capacity],
+                capacity,
+                false,
+                [](uint8_t* data, size_t, bool) {
+                    delete[] data;
+                }
+            );
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    int SimulatedTransport::bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            *transferred = 0;
+            if (!isOpen()) {
+                return LIBUSB_ERROR_NO_DEVICE;
+            }
+            if (!options.endpoints.contains(endpoint)) {
+                return LIBUSB_ERROR_NOT_FOUND;
+            }
+            if (length < 0) {
+                return LIBUSB_ERROR_INVALID_PARAM;
+            }
+            if (token && token->isCancelled()) {
+                return LIBUSB_ERROR_INTERRUPTED;
+            }
+
+            if (!(endpoint & LIBUSB_ENDPOINT_IN)) {
+                delay((size_t) length);
+                std::unique_lock<std::mutex> lock(mutex);
+                if (lost) {
+                    return LIBUSB_ERROR_NO_DEVICE;
+                }
+                lock.unlock();
+                std::vector<uint8_t> value(data, data + length);
+                std::vector<uint8_t> response = options.transform ? options.transform(endpoint, value) : value;
+                uint8_t readEndpoint = endpoint | LIBUSB_ENDPOINT_IN;
+                if (!response.empty() && options.endpoints.contains(readEndpoint)) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queues[readEndpoint].emplace_back(std::move(response));
+                }
+                condition.notify_all();
+                *transferred = length;
+                return LIBUSB_SUCCESS;
+            }
+
+            // subscribed outside the lock, 'cancel' runs the callback under the token lock
+            size_t subscription = token ? token->subscribe([this]() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                }
+                condition.notify_all();
+            }) : 0;
+            int result = read(endpoint, data, length, transferred, timeout, token);
+            if (token) {
+                token->unsubscribe(subscription);
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::setSpinBudget(uint32_t value) {
+        try {
+            spinBudget = value;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint32_t SimulatedTransport::getSpinBudget() {
+        try {
+            return spinBudget;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    ITransport::PollStats SimulatedTransport::getPollStats() {
+        try {
+            PollStats result = {};
+            result.spinHits = spinHits;
+            result.spinMisses = spinMisses;
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::close() {
+        try {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queues.clear();
+                interfaceNumber = {};
+                lost = false;
+                generation++;
+                device = {};
+            }
+            // wakes blocked readers, they see the generation change and leave without touching the cleared queues
+            condition.notify_all();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::destroy() {
+        try {
+            initialized = false;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::disconnect(size_t index) {
+        try {
+            if (index >= options.deviceCount) {
+                throw std::runtime_error(CALL_INFO + ": index: " + std::to_string(index) + " out of range!");
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            disconnected.insert(index);
+            if (!device.empty() && device.at("port") == index + 1) {
+                lost = true;
+            }
+            condition.notify_all();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::connect(size_t index) {
+        try {
+            if (index >= options.deviceCount) {
+                throw std::runtime_error(CALL_INFO + ": index: " + std::to_string(index) + " out of range!");
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (disconnected.erase(index) > 0) {
+                addresses.at(index) = nextAddress;
+                nextAddress = nextAddress >= 127 ? 1 : nextAddress + 1;
+            }
+            condition.notify_all();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void SimulatedTransport::delay(size_t size) {
+        try {
+            std::chrono::microseconds value = options.latency;
+            if (options.bandwidth > 0) {
+                value += std::chrono::microseconds((size * 1000000) / options.bandwidth);
+            }
+            if (value.count() > 0) {
+                std::this_thread::sleep_for(value);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    int SimulatedTransport::read(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) {
+        try {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (device.empty()) {
+                return LIBUSB_ERROR_NO_DEVICE;
+            }
+            uint64_t current = generation;
+            std::deque<std::vector<uint8_t>>& queue = queues[endpoint];
+            if (lost) {
+                return LIBUSB_ERROR_NO_DEVICE;
+            }
+            if (queue.empty() && options.source) {
+                std::vector<uint8_t> value = options.source(endpoint, length);
+                if (!value.empty()) {
+                    queue.emplace_back(std::move(value));
+                }
+            }
+            auto ready = [this, current, &queue, &token]() { return generation != current || lost || !queue.empty() || (token && token->isCancelled()); };
+            uint32_t budget = spinBudget.load(std::memory_order_relaxed);
+            if (budget > 0) {
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(budget);
+                while (!ready() && std::chrono::steady_clock::now() < deadline) {
+                    lock.unlock();
+                    std::this_thread::yield();
+                    lock.lock();
+                }
+                (ready() ? spinHits : spinMisses).fetch_add(1, std::memory_order_relaxed);
+            }
+            if (timeout == 0) {
+                condition.wait(lock, ready);
+            } else if (!condition.wait_for(lock, std::chrono::milliseconds(timeout), ready)) {
+                return LIBUSB_ERROR_TIMEOUT;
+            }
+            if (generation != current || lost) {
+                return LIBUSB_ERROR_NO_DEVICE;
+            }
+            if (queue.empty()) {
+                return LIBUSB_ERROR_INTERRUPTED;
+            }
+            std::vector<uint8_t>& front = queue.front();
+            size_t size = std::min(front.size(), (size_t) length);
+            std::memcpy(data, front.data(), size);
+            if (size == front.size()) {
+                queue.pop_front();
+            } else {
+                front.erase(front.begin(), front.begin() + (std::ptrdiff_t) size);
+            }
+            lock.unlock();
+            delay(size);
+            *transferred = (int32_t) size;
+            return LIBUSB_SUCCESS;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<std::map<std::string, uint16_t>> SimulatedTransport::toDevices() {
+        try {
+            std::vector<std::map<std::string, uint16_t>> result = {};
+            result.reserve(options.deviceCount);
+            for (size_t i = 0; i < options.deviceCount; i++) {
+                if (disconnected.contains(i)) {
+                    continue;
+                }
+                result.emplace_back(toMap(i));
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::map<std::string, uint16_t> SimulatedTransport::toMap(size_t index) {
+        try {
+            std::map<std::string, uint16_t> result = {};
+            result.insert({"vendor", options.vendor});
+            result.insert({"product", options.product});
+            result.insert({"port", (uint16_t) (index + 1)});
+            result.insert({"bus", (uint16_t) 1});
+            result.insert({"address", addresses.at(index)});
+            result.insert({"portPath0", (uint16_t) (index + 1)});
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
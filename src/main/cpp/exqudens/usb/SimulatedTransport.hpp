@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <chrono>
+#include <set>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+#include "exqudens/usb/ITransport.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * In-process device simulation.
+    * Data written to the OUT endpoint 'n' is passed through 'transform' and queued on the IN endpoint 'n | 0x80'.
+    */
+    class EXQUDENS_USB_EXPORT SimulatedTransport: public virtual ITransport {
+
+        public:
+
+            inline static const char* NAME = "simulated";
+
+            struct Options {
+                size_t deviceCount = 1;
+                uint16_t vendor = 0x0484;
+                uint16_t product = 0x5741;
+                uint8_t deviceClass = 0xFF;
+                std::string manufacturer = "exqudens";
+                std::string productName = "Simulated Device";
+                std::string serialPrefix = "SIM"; //!< Device 'i' reports serial 'serialPrefix + (i + 1)'.
+                std::set<uint8_t> endpoints = {0x01, 0x81};
+                std::function<std::vector<uint8_t>(uint8_t endpoint, const std::vector<uint8_t>& value)> transform = {}; //!< Empty for echo, returned empty vector means no response.
+                std::function<std::vector<uint8_t>(uint8_t endpoint, int32_t length)> source = {}; //!< Produces IN data when nothing was queued by writes, returned empty vector means wait.
+                std::chrono::microseconds latency = std::chrono::microseconds(0); //!< Added to every completed transfer.
+                size_t bandwidth = 0; //!< Bytes per second, '0' for unlimited.
+            };
+
+        private:
+
+            Options options = {};
+            std::atomic<bool> initialized = false;
+            std::map<std::string, uint16_t> device = {};
+            std::optional<int32_t> interfaceNumber = {};
+            std::mutex mutex = {};
+            std::condition_variable condition = {};
+            std::map<uint8_t, std::deque<std::vector<uint8_t>>> queues = {};
+            std::vector<uint16_t> addresses = {};
+            std::set<size_t> disconnected = {};
+            uint16_t nextAddress = 0;
+            bool lost = false;
+            uint64_t generation = 0;
+            std::atomic<uint32_t> spinBudget = 0;
+            std::atomic<uint64_t> spinHits = 0;
+            std::atomic<uint64_t> spinMisses = 0;
+
+        public:
+
+            explicit SimulatedTransport(const Options& options);
+            SimulatedTransport();
+
+            Options getOptions();
+
+            std::string getName() override;
+
+            void init() override;
+
+            bool isInitialized() override;
+
+            std::vector<std::map<std::string, uint16_t>> listDevices() override;
+            std::vector<std::map<std::string, uint16_t>> listDevices(const DeviceFilter& filter) override;
+
+            std::optional<std::string> getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) override;
+
+            void open(const std::map<std::string, uint16_t>& value, int32_t interfaceNumber, const std::optional<bool>& detachKernelDriver) override;
+
+            bool isOpen() override;
+
+            std::map<std::string, uint16_t> waitForDevice(const std::map<std::string, uint16_t>& value, uint32_t timeout) override;
+
+            Buffer allocateBuffer(size_t capacity) override;
+
+            int bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) override;
+
+            void setSpinBudget(uint32_t value) override;
+
+            uint32_t getSpinBudget() override;
+
+            PollStats getPollStats() override;
+
+            void close() override;
+
+            void destroy() override;
+
+            /*!
+            * Unplugs the device with 'index', transfers on it fail with 'LIBUSB_ERROR_NO_DEVICE'.
+            */
+            void disconnect(size_t index);
+
+            /*!
+            * Plugs the device with 'index' back in, it re-enumerates with a new address.
+            */
+            void connect(size_t index);
+
+            ~SimulatedTransport() noexcept override = default;
+
+        private:
+
+            void delay(size_t size);
+
+            int read(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token);
+
+            std::vector<std::map<std::string, uint16_t>> toDevices();
+
+            std::map<std::string, uint16_t> toMap(size_t index);
+
+    };
+
+}
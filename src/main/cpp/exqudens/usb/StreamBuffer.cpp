@@ -0,0 +1,182 @@
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+#include <libusb.h>
+
+#include "exqudens/usb/StreamBuffer.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    StreamBuffer::StreamBuffer(
+        const std::shared_ptr<IClient>& client,
+        uint8_t readEndpoint,
+        uint8_t writeEndpoint,
+        uint32_t timeout,
+        size_t capacity,
+        size_t packetSize
+    ):
+        client(client),
+        readEndpoint(readEndpoint),
+        writeEndpoint(writeEndpoint),
+        timeout(timeout)
+    {
+        try {
+            if (!this->client) {
+                throw std::runtime_error(CALL_INFO + ": client is null!");
+            }
+            if (capacity == 0 || packetSize == 0) {
+                throw std::runtime_error(CALL_INFO + ": capacity: " + std::to_string(capacity) + " packetSize: " + std::to_string(packetSize) + " must be greater zero!");
+            }
+
+            // IN transfers shorter than a packet multiple overflow when the device sends a full packet
+            size_t packetCapacity = ((capacity + packetSize - 1) / packetSize) * packetSize;
+            readBuffer = this->client->allocateBuffer(packetCapacity);
+            writeBuffer = this->client->allocateBuffer(packetCapacity);
+
+            char* readBegin = (char*) readBuffer.getData();
+            setg(readBegin, readBegin, readBegin);
+            char* writeBegin = (char*) writeBuffer.getData();
+            setp(writeBegin, writeBegin + writeBuffer.getCapacity());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    StreamBuffer::StreamBuffer(
+        const std::shared_ptr<IClient>& client,
+        uint8_t endpoint,
+        uint32_t timeout
+    ): StreamBuffer(
+        client,
+        (uint8_t) ((endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK) | LIBUSB_ENDPOINT_IN),
+        (uint8_t) ((endpoint & LIBUSB_ENDPOINT_ADDRESS_MASK) | LIBUSB_ENDPOINT_OUT),
+        timeout,
+        16 * PACKET_SIZE,
+        PACKET_SIZE
+    ) {}
+
+    std::vector<uint8_t> StreamBuffer::readExact(size_t size) {
+        try {
+            std::vector<uint8_t> result = {};
+            result.reserve(size);
+            while (result.size() < size) {
+                if (gptr() == egptr() && traits_type::eq_int_type(underflow(), traits_type::eof())) {
+                    throw std::runtime_error(CALL_INFO + ": end of stream after: " + std::to_string(result.size()) + " of: " + std::to_string(size) + " bytes");
+                }
+                size_t available = std::min((size_t) (egptr() - gptr()), size - result.size());
+                result.insert(result.end(), (uint8_t*) gptr(), (uint8_t*) gptr() + available);
+                gbump((int) available);
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    uint8_t StreamBuffer::peek() {
+        try {
+            int_type value = sgetc();
+            if (traits_type::eq_int_type(value, traits_type::eof())) {
+                throw std::runtime_error(CALL_INFO + ": end of stream");
+            }
+            return (uint8_t) traits_type::to_char_type(value);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void StreamBuffer::flush() {
+        try {
+            size_t size = (size_t) (pptr() - pbase());
+            while (size > 0) {
+                writeBuffer.setSize(size);
+                size_t written = client->bulkWrite(writeBuffer, writeEndpoint, timeout, false);
+                writeCount++;
+                if (written == 0) {
+                    throw std::runtime_error(CALL_INFO + ": nothing written of: " + std::to_string(size) + " bytes");
+                }
+                size -= std::min(written, size);
+                if (size > 0) {
+                    std::memmove(writeBuffer.getData(), writeBuffer.getData() + written, size);
+                }
+            }
+            char* writeBegin = (char*) writeBuffer.getData();
+            setp(writeBegin, writeBegin + writeBuffer.getCapacity());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t StreamBuffer::getReadCount() {
+        try {
+            return readCount;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t StreamBuffer::getWriteCount() {
+        try {
+            return writeCount;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    StreamBuffer::~StreamBuffer() noexcept {
+        try {
+            if (client && client->isOpen()) {
+                flush();
+            }
+        } catch (...) {
+        }
+    }
+
+    StreamBuffer::int_type StreamBuffer::underflow() {
+        try {
+            if (gptr() < egptr()) {
+                return traits_type::to_int_type(*gptr());
+            }
+            client->bulkRead(readBuffer, readEndpoint, timeout, false);
+            readCount++;
+            char* readBegin = (char*) readBuffer.getData();
+            setg(readBegin, readBegin, readBegin + readBuffer.getSize());
+            // zero length packet
+            if (gptr() == egptr()) {
+                return traits_type::eof();
+            }
+            return traits_type::to_int_type(*gptr());
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    StreamBuffer::int_type StreamBuffer::overflow(int_type value) {
+        try {
+            flush();
+            if (!traits_type::eq_int_type(value, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(value);
+                pbump(1);
+            }
+            return traits_type::not_eof(value);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    int StreamBuffer::sync() {
+        try {
+            flush();
+            return 0;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
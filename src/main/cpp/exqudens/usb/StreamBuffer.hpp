@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <streambuf>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Buffered 'std::streambuf' over a bulk IN/OUT endpoint pair of an open client.
+    * Reads ahead whole packets into the internal buffer, writes are batched until 'flush' or the buffer is full.
+    * Transfer errors are thrown, 'std::istream' / 'std::ostream' report them as 'badbit'.
+    */
+    class EXQUDENS_USB_EXPORT StreamBuffer: public std::streambuf {
+
+        public:
+
+            inline static const size_t PACKET_SIZE = 512;
+
+        private:
+
+            std::shared_ptr<IClient> client = nullptr;
+            uint8_t readEndpoint = 0;
+            uint8_t writeEndpoint = 0;
+            uint32_t timeout = 0;
+            Buffer readBuffer = {};
+            Buffer writeBuffer = {};
+            size_t readCount = 0;
+            size_t writeCount = 0;
+
+        public:
+
+            StreamBuffer(
+                const std::shared_ptr<IClient>& client,
+                uint8_t readEndpoint, //!< IN endpoint address, e.g. '0x81'.
+                uint8_t writeEndpoint, //!< OUT endpoint address, e.g. '0x01'.
+                uint32_t timeout, //!< Per transfer, '0' for unlimited.
+                size_t capacity, //!< Rounded up to a multiple of 'packetSize'.
+                size_t packetSize
+            );
+            StreamBuffer(
+                const std::shared_ptr<IClient>& client,
+                uint8_t endpoint,
+                uint32_t timeout
+            );
+            StreamBuffer(const StreamBuffer& other) = delete;
+
+            StreamBuffer& operator=(const StreamBuffer& other) = delete;
+
+            /*!
+            * Reads exactly 'size' bytes, refilling the buffer as needed.
+            *
+            * @throws std::runtime_error
+            */
+            std::vector<uint8_t> readExact(size_t size);
+
+            /*!
+            * Returns the next byte without consuming it.
+            *
+            * @throws std::runtime_error
+            */
+            uint8_t peek();
+
+            /*!
+            * Writes the pending output.
+            *
+            * @throws std::runtime_error
+            */
+            void flush();
+
+            /*!
+            * @return A number of bulk read transfers issued.
+            */
+            size_t getReadCount();
+
+            /*!
+            * @return A number of bulk write transfers issued.
+            */
+            size_t getWriteCount();
+
+            ~StreamBuffer() noexcept override;
+
+        protected:
+
+            int_type underflow() override;
+
+            int_type overflow(int_type value) override;
+
+            int sync() override;
+
+    };
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace exqudens::usb {
+
+    /*!
+    * String descriptors referenced by the device descriptor ('iManufacturer', 'iProduct', 'iSerialNumber').
+    */
+    enum class StringDescriptor {
+        MANUFACTURER,
+        PRODUCT,
+        SERIAL_NUMBER
+    };
+
+}
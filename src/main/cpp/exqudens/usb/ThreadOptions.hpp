@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+
+namespace exqudens::usb {
+
+    /*!
+    * Scheduling of the thread that services USB events, empty fields leave the thread as it is.
+    * Transfers are synchronous, so the event thread is the thread calling the transfer functions,
+    * it opts in with 'IClient::tuneCurrentThread'.
+    */
+    struct ThreadOptions {
+
+        enum class Policy {
+            DEFAULT,
+            FIFO, //!< 'SCHED_FIFO'.
+            ROUND_ROBIN //!< 'SCHED_RR'.
+        };
+
+        std::set<size_t> cpus = {}; //!< CPU affinity.
+        Policy policy = Policy::DEFAULT;
+        int priority = 0; //!< Real-time priority of 'FIFO' and 'ROUND_ROBIN', clamped to the range of the policy.
+        bool lockMemory = false; //!< 'mlockall' current and future pages, transfer buffers included.
+        uint32_t spinBudget = 0; //!< Microseconds to busy poll for a completion before blocking, see 'ITransport::setSpinBudget'.
+        bool strict = false; //!< Throw if an option can not be applied instead of only reporting it.
+
+    };
+
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <filesystem>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+#include "exqudens/usb/ThreadTuning.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    std::vector<std::string> ThreadTuning::apply(const ThreadOptions& options) {
+        try {
+            std::vector<std::string> result = {};
+
+#if defined(__linux__)
+            if (!options.cpus.empty()) {
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                for (size_t cpu : options.cpus) {
+                    if (cpu >= CPU_SETSIZE) {
+                        result.emplace_back("cpus: '" + std::to_string(cpu) + "' is out of range");
+                        continue;
+                    }
+                    CPU_SET(cpu, &cpuSet);
+                }
+                if (CPU_COUNT(&cpuSet) > 0) {
+                    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+                    if (error) {
+                        result.emplace_back("cpus: '" + std::string(std::strerror(error)) + "'");
+                    }
+                }
+            }
+
+            if (options.policy != ThreadOptions::Policy::DEFAULT) {
+                int policy = options.policy == ThreadOptions::Policy::FIFO ? SCHED_FIFO : SCHED_RR;
+                sched_param param = {};
+                param.sched_priority = std::clamp(options.priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+                int error = pthread_setschedparam(pthread_self(), policy, &param);
+                if (error) {
+                    result.emplace_back("policy: '" + std::string(std::strerror(error)) + "'");
+                }
+            }
+
+            if (options.lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+                result.emplace_back("lockMemory: '" + std::string(std::strerror(errno)) + "'");
+            }
+#else
+            if (!isEmpty(options)) {
+                result.emplace_back("not supported on this platform");
+            }
+#endif
+
+            if (options.strict && !result.empty()) {
+                std::string message = {};
+                for (const std::string& error : result) {
+                    message += message.empty() ? error : ", " + error;
+                }
+                throw std::runtime_error(CALL_INFO + ": " + message);
+            }
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool ThreadTuning::isEmpty(const ThreadOptions& options) {
+        try {
+            return options.cpus.empty() && options.policy == ThreadOptions::Policy::DEFAULT && !options.lockMemory;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "exqudens/usb/export.hpp"
+#include "exqudens/usb/ThreadOptions.hpp"
+
+namespace exqudens::usb {
+
+    class EXQUDENS_USB_EXPORT ThreadTuning {
+
+        public:
+
+            /*!
+            * Applies 'options' to the calling thread, every option is tried even if a previous one failed.
+            *
+            * @return Options that could not be applied with the reason, e.g. missing 'CAP_SYS_NICE' or an unsupported platform.
+            *
+            * @throws std::runtime_error If 'ThreadOptions::strict' is set and an option could not be applied.
+            */
+            static std::vector<std::string> apply(const ThreadOptions& options);
+
+            static bool isEmpty(const ThreadOptions& options);
+
+    };
+
+}
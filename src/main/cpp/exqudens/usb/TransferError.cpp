@@ -0,0 +1,38 @@
+#include "exqudens/usb/TransferError.hpp"
+
+namespace exqudens::usb {
+
+    TransferError::TransferError(
+        const std::string& message,
+        int libusbError,
+        size_t transferred
+    ):
+        std::runtime_error(message),
+        libusbError(libusbError),
+        transferred(transferred)
+    {
+    }
+
+    int TransferError::getLibusbError() const noexcept {
+        return libusbError;
+    }
+
+    size_t TransferError::getTransferred() const noexcept {
+        return transferred;
+    }
+
+    std::optional<TransferError> TransferError::find(const std::exception& exception) {
+        if (const TransferError* error = dynamic_cast<const TransferError*>(&exception)) {
+            return *error;
+        }
+        try {
+            std::rethrow_if_nested(exception);
+            return {};
+        } catch (const std::exception& e) {
+            return find(e);
+        } catch (...) {
+            return {};
+        }
+    }
+
+}
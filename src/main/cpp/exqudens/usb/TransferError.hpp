@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <optional>
+#include <exception>
+#include <stdexcept>
+
+#include "exqudens/usb/export.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Failed bulk transfer with its libusb error code and the bytes moved before it failed,
+    * e.g. a read ending in 'LIBUSB_ERROR_TIMEOUT' after a burst that filled whole packets.
+    */
+    class EXQUDENS_USB_EXPORT TransferError: public std::runtime_error {
+
+        private:
+
+            int libusbError = 0;
+            size_t transferred = 0;
+
+        public:
+
+            TransferError(
+                const std::string& message,
+                int libusbError, //!< 'libusb_error' code, e.g. 'LIBUSB_ERROR_TIMEOUT'.
+                size_t transferred //!< Bytes moved before the error, valid in the caller buffer.
+            );
+
+            int getLibusbError() const noexcept;
+
+            size_t getTransferred() const noexcept;
+
+            /*!
+            * @return The first transfer error in the nested chain of 'exception', empty if there is none.
+            */
+            static std::optional<TransferError> find(const std::exception& exception);
+
+    };
+
+}
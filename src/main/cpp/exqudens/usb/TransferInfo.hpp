@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+
+namespace exqudens::usb {
+
+    /*!
+    * Timing of one bulk transfer, recorded by 'IClient' while the timeline is enabled.
+    */
+    struct TransferInfo {
+        uint64_t sequence = 0; //!< Per client, in submit order starting at '1'.
+        uint8_t endpoint = 0; //!< Endpoint address, direction included.
+        size_t requested = 0; //!< Bytes to write or read buffer capacity.
+        size_t transferred = 0;
+        int libusbError = 0; //!< '0' on success.
+        std::chrono::steady_clock::time_point submittedAt = {};
+        std::chrono::steady_clock::time_point completedAt = {};
+    };
+
+}
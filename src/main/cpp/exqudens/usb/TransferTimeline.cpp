@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+
+#include <libusb.h>
+
+#include "exqudens/usb/TransferTimeline.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    std::string TransferTimeline::toChromeTrace(const std::vector<TransferInfo>& value) {
+        try {
+            auto toMicroseconds = [](const std::chrono::steady_clock::duration& duration) {
+                return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 1000.0;
+            };
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(3);
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            bool first = true;
+            // async begin/end pairs matched by the sequence, overlapping transfers of one endpoint do not have to nest
+            for (const TransferInfo& transfer : value) {
+                std::ostringstream name;
+                name << (transfer.endpoint & LIBUSB_ENDPOINT_IN ? "IN" : "OUT") << " 0x" << std::hex << std::setw(2) << std::setfill('0') << (int) transfer.endpoint;
+                std::ostringstream event;
+                event << "{\"name\":\"" << name.str() << "\",\"cat\":\"usb\",\"id\":" << transfer.sequence << ",\"pid\":1,\"tid\":" << (int) transfer.endpoint;
+                out << (first ? "" : ",");
+                out << event.str() << ",\"ph\":\"b\",\"ts\":" << toMicroseconds(transfer.submittedAt.time_since_epoch());
+                out << ",\"args\":{\"sequence\":" << transfer.sequence;
+                out << ",\"requested\":" << transfer.requested << "}}";
+                out << "," << event.str() << ",\"ph\":\"e\",\"ts\":" << toMicroseconds(transfer.completedAt.time_since_epoch());
+                out << ",\"args\":{\"result\":\"" << (transfer.libusbError == 0 ? "LIBUSB_SUCCESS" : libusb_error_name(transfer.libusbError)) << "\"";
+                out << ",\"transferred\":" << transfer.transferred;
+                out << ",\"libusbError\":" << transfer.libusbError << "}}";
+                first = false;
+            }
+            out << "]}";
+            return out.str();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    TransferTimeline::TransferTimeline(size_t capacity): capacity(capacity) {}
+
+    TransferTimeline::TransferTimeline(): TransferTimeline(0) {}
+
+    void TransferTimeline::setCapacity(size_t value) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            capacity = value;
+            for (auto& [endpoint, queue] : transfers) {
+                while (queue.size() > value) {
+                    queue.pop_front();
+                }
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    size_t TransferTimeline::getCapacity() {
+        try {
+            return capacity;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    bool TransferTimeline::isEnabled() {
+        try {
+            return capacity.load(std::memory_order_relaxed) > 0;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void TransferTimeline::add(const TransferInfo& value) {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (capacity == 0) {
+                return;
+            }
+            std::deque<TransferInfo>& queue = transfers[value.endpoint];
+            if (queue.size() >= capacity) {
+                queue.pop_front();
+            }
+            queue.emplace_back(value);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<TransferInfo> TransferTimeline::get() {
+        try {
+            std::vector<TransferInfo> result = {};
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto& [endpoint, queue] : transfers) {
+                    result.insert(result.end(), queue.begin(), queue.end());
+                }
+            }
+            std::sort(result.begin(), result.end(), [](const TransferInfo& a, const TransferInfo& b) { return a.sequence < b.sequence; });
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void TransferTimeline::clear() {
+        try {
+            std::lock_guard<std::mutex> lock(mutex);
+            transfers.clear();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+#include "exqudens/usb/export.hpp"
+#include "exqudens/usb/TransferInfo.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * In-memory ring of the most recent transfers per endpoint, a capacity of '0' disables the recording.
+    */
+    class EXQUDENS_USB_EXPORT TransferTimeline {
+
+        public:
+
+            /*!
+            * Chrome trace event format JSON (chrome://tracing, Perfetto), an async begin/end pair per transfer with the sequence as id,
+            * so overlapping transfers draw side by side on the track of their endpoint, microsecond timestamps of the steady clock.
+            */
+            static std::string toChromeTrace(const std::vector<TransferInfo>& value);
+
+        private:
+
+            std::atomic<size_t> capacity = 0;
+            std::mutex mutex = {};
+            std::map<uint8_t, std::deque<TransferInfo>> transfers = {};
+
+        public:
+
+            explicit TransferTimeline(
+                size_t capacity //!< Transfers kept per endpoint.
+            );
+            TransferTimeline();
+            TransferTimeline(const TransferTimeline& other) = delete;
+
+            TransferTimeline& operator=(const TransferTimeline& other) = delete;
+
+            /*!
+            * Drops the oldest transfers above the new capacity.
+            */
+            void setCapacity(size_t value);
+
+            size_t getCapacity();
+
+            bool isEnabled();
+
+            void add(const TransferInfo& value);
+
+            /*!
+            * @return The kept transfers of every endpoint in submit order.
+            */
+            std::vector<TransferInfo> get();
+
+            void clear();
+
+    };
+
+}
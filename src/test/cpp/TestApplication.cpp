@@ -18,6 +18,21 @@
 
 // include test files
 #include "unit/IClientUnitTests.hpp"
+#include "unit/ClientPoolUnitTests.hpp"
+#include "unit/StreamBufferUnitTests.hpp"
+#include "unit/CoalescingWriterUnitTests.hpp"
+#include "unit/DeviceGroupUnitTests.hpp"
+#include "unit/CompletionDispatcherUnitTests.hpp"
+#include "unit/ThreadTuningUnitTests.hpp"
+#include "unit/RecorderUnitTests.hpp"
+#include "unit/FramerUnitTests.hpp"
+#include "unit/AdaptiveReaderUnitTests.hpp"
+#include "unit/PriorityWriterUnitTests.hpp"
+#include "unit/SharedMemoryUnitTests.hpp"
+#include "unit/TransferTimelineUnitTests.hpp"
+#include "unit/DeviceIndexUnitTests.hpp"
+#include "unit/LoadGeneratorUnitTests.hpp"
+#include "unit/LibusbTransferPoolUnitTests.hpp"
 #include "system/IClientSystemTests.hpp"
 
 #define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
@@ -40,6 +55,21 @@ int TestApplication::run(int argc, char** argv) {
             LOGGER_ID,
             exqudens::usb::Client::LOGGER_ID,
             exqudens::usb::IClientUnitTests::LOGGER_ID,
+            exqudens::usb::ClientPoolUnitTests::LOGGER_ID,
+            exqudens::usb::StreamBufferUnitTests::LOGGER_ID,
+            exqudens::usb::CoalescingWriterUnitTests::LOGGER_ID,
+            exqudens::usb::DeviceGroupUnitTests::LOGGER_ID,
+            exqudens::usb::CompletionDispatcherUnitTests::LOGGER_ID,
+            exqudens::usb::ThreadTuningUnitTests::LOGGER_ID,
+            exqudens::usb::RecorderUnitTests::LOGGER_ID,
+            exqudens::usb::FramerUnitTests::LOGGER_ID,
+            exqudens::usb::AdaptiveReaderUnitTests::LOGGER_ID,
+            exqudens::usb::PriorityWriterUnitTests::LOGGER_ID,
+            exqudens::usb::SharedMemoryUnitTests::LOGGER_ID,
+            exqudens::usb::TransferTimelineUnitTests::LOGGER_ID,
+            exqudens::usb::DeviceIndexUnitTests::LOGGER_ID,
+            exqudens::usb::LoadGeneratorUnitTests::LOGGER_ID,
+            exqudens::usb::LibusbTransferPoolUnitTests::LOGGER_ID,
             exqudens::usb::IClientSystemTests::LOGGER_ID
         };
         std::string loggingConfigResult = exqudens::Log::configure(loggingFile, loggingFileSize, loggerIdSet);
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <span>
+#include <atomic>
+#include <stdexcept>
+#include <optional>
+#include <algorithm>
+#include <cstring>
+
+#include <libusb.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/AdaptiveReader.hpp"
+#include "exqudens/usb/TransferError.hpp"
+
+namespace exqudens::usb {
+
+    class AdaptiveReaderUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "AdaptiveReaderUnitTests";
+
+    };
+
+    TEST_F(AdaptiveReaderUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            // one burst of 31 packets, then silence
+            std::atomic<bool> idle = false;
+            SimulatedTransport::Options transportOptions = {};
+            transportOptions.source = [&idle](uint8_t endpoint, int32_t length) {
+                return idle.exchange(true) ? std::vector<uint8_t>() : std::vector<uint8_t>(31 * 512, 0x55);
+            };
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(transportOptions);
+            client->open(client->listDevices().front());
+
+            AdaptiveReader::Options options = {};
+            options.packetSize = 512;
+            options.minPackets = 1;
+            options.maxPackets = 8;
+            options.minTimeout = 1;
+            options.maxTimeout = 8;
+            AdaptiveReader reader(client, 0x81, options);
+
+            ASSERT_EQ(512, reader.getStats().readSize);
+            ASSERT_EQ(8, reader.getStats().timeout);
+
+            std::vector<size_t> sizes = {};
+            for (size_t i = 0; i < 6; i++) {
+                sizes.emplace_back(reader.read().size());
+            }
+
+            ASSERT_EQ(std::vector<size_t>({512, 1024, 2048, 4096, 4096, 4096}), sizes);
+            ASSERT_EQ(4096, reader.getStats().readSize);
+            ASSERT_EQ(6, reader.getStats().fullReads);
+            ASSERT_EQ(1, reader.getStats().timeout);
+
+            std::vector<uint32_t> timeouts = {};
+            for (size_t i = 0; i < 5; i++) {
+                ASSERT_TRUE(reader.read().empty());
+                timeouts.emplace_back(reader.getStats().timeout);
+            }
+
+            ASSERT_EQ(std::vector<uint32_t>({2, 4, 8, 8, 8}), timeouts);
+            ASSERT_EQ(11, reader.getStats().reads);
+            ASSERT_EQ(5, reader.getStats().emptyReads);
+            ASSERT_EQ(512 + 1024 + 2048 + 4096 * 3, reader.getStats().bytes);
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(AdaptiveReaderUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            // large responses first, then small messages shrink the read size back
+            std::atomic<size_t> responseSize = 15 * 512;
+            SimulatedTransport::Options transportOptions = {};
+            transportOptions.source = [&responseSize](uint8_t endpoint, int32_t length) {
+                return std::vector<uint8_t>(responseSize, 0x55);
+            };
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(transportOptions);
+            client->open(client->listDevices().front());
+
+            AdaptiveReader::Options options = {};
+            options.maxPackets = 8;
+            AdaptiveReader reader(client, 0x81, options);
+            for (size_t i = 0; i < 4; i++) {
+                reader.read();
+            }
+
+            ASSERT_EQ(4096, reader.getStats().readSize);
+
+            responseSize = 100;
+            for (size_t i = 0; i < 32; i++) {
+                ASSERT_EQ(100, reader.read().size());
+            }
+
+            ASSERT_EQ(512, reader.getStats().readSize);
+            ASSERT_NEAR(100, reader.getStats().averageSize, 1);
+
+            client->close();
+
+            ASSERT_THROW(reader.read(), std::runtime_error);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(AdaptiveReaderUnitTests, test3) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            // bursts of two full packets, a larger read gets no short packet and times out with the burst received
+            class BurstTransport: public SimulatedTransport {
+
+                public:
+
+                    std::atomic<uint8_t> next = 0;
+
+                    explicit BurstTransport(const Options& options): SimulatedTransport(options) {}
+
+                    int bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) override {
+                        if ((endpoint & 0x80) == 0) {
+                            return SimulatedTransport::bulkTransfer(endpoint, data, length, transferred, timeout, token);
+                        }
+                        *transferred = std::min(length, 1024);
+                        std::memset(data, next++, (size_t) *transferred);
+                        return length > 1024 ? LIBUSB_ERROR_TIMEOUT : 0;
+                    }
+
+            };
+
+            std::shared_ptr<BurstTransport> transport = std::make_shared<BurstTransport>(SimulatedTransport::Options {});
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            client->open(client->listDevices().front());
+            std::optional<TransferError> error = {};
+
+            try {
+                client->bulkRead(0x81, 8, 4096);
+            } catch (const std::exception& e) {
+                error = TransferError::find(e);
+            }
+
+            ASSERT_TRUE(error.has_value());
+            ASSERT_EQ(LIBUSB_ERROR_TIMEOUT, error.value().getLibusbError());
+            ASSERT_EQ(1024, error.value().getTransferred());
+
+            AdaptiveReader::Options options = {};
+            options.maxPackets = 8;
+            AdaptiveReader reader(client, 0x81, options);
+            std::vector<size_t> sizes = {};
+            std::vector<uint8_t> values = {};
+            for (size_t i = 0; i < 6; i++) {
+                std::span<const uint8_t> data = reader.read();
+                sizes.emplace_back(data.size());
+                values.emplace_back(data.front());
+            }
+
+            // no burst is dropped and the read size stays at the burst size
+            ASSERT_EQ(std::vector<size_t>({512, 1024, 1024, 1024, 1024, 1024}), sizes);
+            ASSERT_EQ(std::vector<uint8_t>({1, 2, 3, 4, 5, 6}), values);
+            ASSERT_EQ(1024, reader.getStats().readSize);
+            ASSERT_EQ(1, reader.getStats().partialReads);
+            ASSERT_EQ(0, reader.getStats().emptyReads);
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    class ClientPoolUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "ClientPoolUnitTests";
+
+    };
+
+    TEST_F(ClientPoolUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            size_t created = 0;
+            SimulatedTransport::Options options = {};
+            options.deviceCount = 2;
+            std::shared_ptr<ClientPool> pool = ClientFactory::createPoolShared(
+                [&created, &options]() {
+                    created++;
+                    return ClientFactory::createSimulatedShared(options);
+                },
+                std::chrono::milliseconds(60000)
+            );
+            std::vector<std::map<std::string, unsigned short>> devices = ClientFactory::createSimulatedShared(options)->listDevices();
+            std::shared_ptr<IClient> first = nullptr;
+            std::vector<std::string> stackTrace = {};
+
+            {
+                ClientPool::Lease lease = pool->acquire(devices.at(0));
+                first = lease.getClient();
+
+                ASSERT_TRUE(lease->isOpen());
+                ASSERT_EQ(1, pool->getLeasedSize());
+
+                try {
+                    ClientPool::Lease other = pool->acquire(devices.at(0), {}, {}, std::chrono::milliseconds(1));
+                } catch (const std::exception& e) {
+                    stackTrace = TestUtils::toStackTrace(e);
+                }
+
+                ASSERT_FALSE(stackTrace.empty());
+            }
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "created: " << created;
+
+            ASSERT_EQ(1, created);
+            ASSERT_EQ(1, pool->getIdleSize());
+            ASSERT_EQ(0, pool->getLeasedSize());
+
+            {
+                ClientPool::Lease lease = pool->acquire(devices.at(0));
+
+                ASSERT_TRUE(first == lease.getClient());
+
+                ClientPool::Lease other = pool->acquire(devices.at(1));
+
+                ASSERT_FALSE(first == other.getClient());
+                ASSERT_EQ(2, pool->getLeasedSize());
+
+                lease.invalidate();
+            }
+
+            ASSERT_EQ(2, created);
+            ASSERT_EQ(1, pool->getIdleSize());
+            ASSERT_FALSE(first->isOpen());
+
+            {
+                ClientPool::Lease lease = pool->acquire(devices.at(0));
+
+                ASSERT_FALSE(first == lease.getClient());
+            }
+
+            ASSERT_EQ(3, created);
+
+            pool->clear();
+
+            ASSERT_EQ(0, pool->getIdleSize());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(ClientPoolUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<ClientPool> pool = ClientFactory::createPoolShared(
+                []() { return ClientFactory::createSimulatedShared({}); },
+                std::chrono::milliseconds(1)
+            );
+            std::map<std::string, unsigned short> device = ClientFactory::createSimulatedShared({})->listDevices().front();
+            std::shared_ptr<IClient> client = nullptr;
+
+            {
+                ClientPool::Lease lease = pool->acquire(device);
+                client = lease.getClient();
+            }
+
+            ASSERT_EQ(1, pool->getIdleSize());
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            size_t evicted = pool->evictIdle();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "evicted: " << evicted;
+
+            ASSERT_EQ(1, evicted);
+            ASSERT_EQ(0, pool->getIdleSize());
+            ASSERT_FALSE(client->isOpen());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
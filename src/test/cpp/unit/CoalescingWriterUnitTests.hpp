@@ -0,0 +1,149 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <mutex>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/CoalescingWriter.hpp"
+
+namespace exqudens::usb {
+
+    class CoalescingWriterUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "CoalescingWriterUnitTests";
+
+    };
+
+    TEST_F(CoalescingWriterUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::vector<std::vector<uint8_t>> transfers = {};
+            SimulatedTransport::Options options = {};
+            options.transform = [&transfers](uint8_t endpoint, const std::vector<uint8_t>& value) {
+                transfers.emplace_back(value);
+                return std::vector<uint8_t> {};
+            };
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+            client->open(client->listDevices().front());
+
+            {
+                CoalescingWriter writer(client, 0x01, 100, 64, std::chrono::microseconds(0));
+
+                for (uint8_t i = 0; i < 10; i++) {
+                    writer.write(std::vector<uint8_t>(16, i));
+                }
+                EXQUDENS_LOG_INFO(LOGGER_ID) << "transfers: " << transfers.size();
+
+                ASSERT_EQ(2, transfers.size());
+                ASSERT_EQ(64, transfers.at(0).size());
+                ASSERT_EQ(32, writer.getPendingSize());
+
+                writer.write(std::vector<uint8_t>(100, 0xFF));
+
+                ASSERT_EQ(4, transfers.size());
+                ASSERT_EQ(32, transfers.at(2).size());
+                ASSERT_EQ(100, transfers.at(3).size());
+
+                writer.write(std::vector<uint8_t>(8, 0xAA));
+                writer.flush();
+
+                ASSERT_EQ(5, transfers.size());
+                ASSERT_EQ(12, writer.getMessageCount());
+                ASSERT_EQ(5, writer.getTransferCount());
+
+                writer.write(std::vector<uint8_t>(8, 0xBB));
+            }
+
+            ASSERT_EQ(6, transfers.size());
+
+            std::vector<uint8_t> all = {};
+            for (const std::vector<uint8_t>& transfer : transfers) {
+                all.insert(all.end(), transfer.begin(), transfer.end());
+            }
+
+            ASSERT_EQ(10 * 16 + 100 + 8 + 8, all.size());
+            for (size_t i = 0; i < 10 * 16; i++) {
+                ASSERT_EQ(i / 16, all.at(i));
+            }
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(CoalescingWriterUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::mutex mutex = {};
+            size_t received = 0;
+            std::vector<std::string> stackTrace = {};
+            SimulatedTransport::Options options = {};
+            options.transform = [&mutex, &received](uint8_t endpoint, const std::vector<uint8_t>& value) {
+                std::lock_guard<std::mutex> lock(mutex);
+                received += value.size();
+                return std::vector<uint8_t> {};
+            };
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+            client->open(client->listDevices().front());
+
+            CoalescingWriter writer(client, 0x01, 100, 4096, std::chrono::microseconds(500));
+            writer.write(std::vector<uint8_t>(8, 0x55));
+            writer.write(std::vector<uint8_t>(8, 0x55));
+
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (writer.getPendingSize() > 0 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "transferCount: " << writer.getTransferCount();
+
+            ASSERT_EQ(0, writer.getPendingSize());
+            ASSERT_EQ(1, writer.getTransferCount());
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ASSERT_EQ(16, received);
+            }
+
+            client->close();
+            writer.write(std::vector<uint8_t>(8, 0x55));
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+            try {
+                writer.flush();
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_FALSE(stackTrace.empty());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
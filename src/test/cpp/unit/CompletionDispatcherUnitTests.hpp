@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/CompletionDispatcher.hpp"
+
+namespace exqudens::usb {
+
+    class CompletionDispatcherUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "CompletionDispatcherUnitTests";
+
+    };
+
+    TEST_F(CompletionDispatcherUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            size_t keyCount = 16;
+            size_t taskCount = 1000;
+            std::vector<std::vector<size_t>> sequences(keyCount);
+            std::vector<std::atomic<int>> running(keyCount);
+            std::atomic<size_t> overlaps = 0;
+            CompletionDispatcher dispatcher(4);
+
+            for (size_t i = 0; i < taskCount; i++) {
+                for (size_t key = 0; key < keyCount; key++) {
+                    dispatcher.dispatch(key, [&sequences, &running, &overlaps, key, i]() {
+                        if (running.at(key)++ != 0) {
+                            overlaps++;
+                        }
+                        sequences.at(key).emplace_back(i);
+                        running.at(key)--;
+                    });
+                }
+            }
+            dispatcher.dispatch(0, []() { throw std::runtime_error("failed"); });
+            dispatcher.waitIdle();
+
+            CompletionDispatcher::Metrics metrics = dispatcher.getMetrics();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "completed: " << metrics.completed << " maxQueueDepth: " << metrics.maxQueueDepth << " stolen: " << metrics.stolen;
+
+            ASSERT_EQ(0, overlaps.load());
+            ASSERT_EQ(keyCount * taskCount + 1, metrics.completed);
+            ASSERT_EQ(1, metrics.failed);
+            ASSERT_EQ(0, metrics.queueDepth);
+            ASSERT_TRUE(metrics.maxQueueDepth > 0);
+            ASSERT_EQ(4, metrics.workerQueueDepths.size());
+            ASSERT_EQ(0, dispatcher.getQueueDepth(0));
+            for (const std::vector<size_t>& sequence : sequences) {
+                ASSERT_EQ(taskCount, sequence.size());
+                for (size_t i = 0; i < sequence.size(); i++) {
+                    ASSERT_EQ(i, sequence.at(i));
+                }
+            }
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(CompletionDispatcherUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            CompletionDispatcher dispatcher(4);
+
+            // every key lands on worker 0, the other workers have to steal
+            for (size_t key = 0; key < 8; key++) {
+                for (size_t i = 0; i < 4; i++) {
+                    dispatcher.dispatch(key * 4, []() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+                }
+            }
+
+            ASSERT_TRUE(dispatcher.getMetrics().queueDepth > 0);
+
+            dispatcher.waitIdle();
+
+            CompletionDispatcher::Metrics metrics = dispatcher.getMetrics();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "stolen: " << metrics.stolen;
+
+            ASSERT_TRUE(metrics.stolen > 0);
+            ASSERT_EQ(32, metrics.completed);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
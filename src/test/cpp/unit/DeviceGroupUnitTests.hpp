@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    class DeviceGroupUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "DeviceGroupUnitTests";
+
+    };
+
+    TEST_F(DeviceGroupUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::vector<std::shared_ptr<IClient>> clients = {};
+            for (size_t i = 0; i < 16; i++) {
+                SimulatedTransport::Options options = {};
+                options.latency = std::chrono::milliseconds(20);
+                options.transform = [i](uint8_t endpoint, const std::vector<uint8_t>& value) {
+                    std::vector<uint8_t> result = value;
+                    result.emplace_back((uint8_t) i);
+                    return result;
+                };
+                std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+                client->open(client->listDevices().front());
+                clients.emplace_back(client);
+            }
+            clients.at(3)->close();
+
+            std::shared_ptr<DeviceGroup> group = ClientFactory::createGroupShared(clients);
+
+            ASSERT_EQ(16, group->getSize());
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            std::vector<DeviceGroup::Result> results = group->transactAll({0x10, 0x20}, 1, 1000, 64);
+            std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "elapsed: " << elapsed.count() << " ms";
+
+            ASSERT_EQ(16, results.size());
+            ASSERT_TRUE(elapsed < std::chrono::milliseconds(16 * 40 / 2));
+            for (size_t i = 0; i < results.size(); i++) {
+                if (i == 3) {
+                    ASSERT_TRUE(results.at(i).error != nullptr);
+                    continue;
+                }
+                ASSERT_TRUE(results.at(i).error == nullptr);
+                ASSERT_EQ(std::vector<uint8_t>({0x10, 0x20, (uint8_t) i}), results.at(i).data);
+            }
+
+            results = group->broadcastWrite({0x30}, 1, 1000);
+
+            ASSERT_EQ(1, results.at(0).size);
+
+            results = group->gatherRead(1, 1000, 64);
+
+            ASSERT_EQ(std::vector<uint8_t>({0x30, 0x05}), results.at(5).data);
+            ASSERT_TRUE(results.at(3).error != nullptr);
+
+            results = group->execute([](size_t index, const std::shared_ptr<IClient>& client) {
+                DeviceGroup::Result result = {};
+                result.size = index;
+                return result;
+            });
+
+            ASSERT_EQ(15, results.at(15).size);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    class DeviceIndexUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "DeviceIndexUnitTests";
+
+    };
+
+    TEST_F(DeviceIndexUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            SimulatedTransport::Options options = {};
+            options.deviceCount = 3;
+            std::shared_ptr<DeviceIndex> index = ClientFactory::createIndexShared([&options]() {
+                return ClientFactory::createSimulatedShared(options);
+            });
+            std::map<std::string, unsigned short> device = {};
+            std::vector<std::string> stackTrace = {};
+
+            // the first lookup misses the empty index and enumerates
+            device = index->findBySerial("SIM2");
+
+            ASSERT_EQ(1, index->getRefreshCount());
+            ASSERT_EQ(3, index->getSize());
+            ASSERT_EQ(2, device.at("port"));
+            ASSERT_EQ(2, device.at("portPath0"));
+            ASSERT_EQ(std::string("1-2"), DeviceIndex::toPortPathName(device));
+
+            ASSERT_EQ(3, index->findByPortPath("1-3").at("port"));
+            ASSERT_EQ(1, index->findByPortPath(1, {1}).at("port"));
+            ASSERT_EQ(3, index->findByVendorProduct(options.vendor, options.product).size());
+            ASSERT_EQ(1, index->getRefreshCount());
+
+            ASSERT_TRUE(index->findBySerial("SIM9").empty());
+            ASSERT_EQ(2, index->getRefreshCount());
+
+            std::shared_ptr<IClient> client = index->openBySerial("SIM1");
+
+            ASSERT_TRUE(client->isOpen());
+            ASSERT_EQ(index->findBySerial("SIM1"), client->getDevice());
+
+            client->close();
+
+            try {
+                index->openByPortPath("1-7");
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_FALSE(stackTrace.empty());
+
+            device = {{"vendor", 1}, {"product", 2}, {"port", 2}, {"bus", 2}, {"address", 9}, {"portPath0", 1}, {"portPath1", 4}, {"portPath2", 2}};
+
+            ASSERT_EQ(std::vector<uint8_t>({1, 4, 2}), DeviceIndex::toPortPath(device));
+            ASSERT_EQ(std::string("2-1.4.2"), DeviceIndex::toPortPathName(device));
+            ASSERT_EQ(std::vector<uint8_t>({5}), DeviceIndex::toPortPath({{"port", 5}, {"bus", 1}}));
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(DeviceIndexUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            SimulatedTransport::Options transportOptions = {};
+            transportOptions.deviceCount = 3;
+            std::shared_ptr<SimulatedTransport> transport = std::make_shared<SimulatedTransport>(transportOptions);
+            DeviceIndex::Options options = {};
+            options.refreshOnMiss = false;
+            DeviceIndex index([&transport]() { return ClientFactory::createShared(true, true, {}, transport); }, options);
+            std::map<std::string, unsigned short> device = {};
+
+            ASSERT_TRUE(index.findBySerial("SIM2").empty());
+            ASSERT_EQ(3, index.refresh());
+
+            device = index.findBySerial("SIM2");
+            transport->disconnect(1);
+            transport->connect(1);
+
+            // stale until refreshed
+            ASSERT_EQ(device, index.findBySerial("SIM2"));
+
+            index.refresh();
+
+            ASSERT_EQ(device.at("port"), index.findBySerial("SIM2").at("port"));
+            ASSERT_NE(device.at("address"), index.findBySerial("SIM2").at("address"));
+            ASSERT_EQ(index.findBySerial("SIM2"), index.findByPortPath("1-2"));
+
+            transport->disconnect(2);
+
+            ASSERT_EQ(2, index.refresh());
+            ASSERT_TRUE(index.findBySerial("SIM3").empty());
+            ASSERT_TRUE(index.findByPortPath("1-3").empty());
+            ASSERT_EQ(2, index.findByVendorProduct(transportOptions.vendor, transportOptions.product).size());
+            ASSERT_EQ(3, index.getRefreshCount());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(DeviceIndexUnitTests, test3) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            // the serial of the device on port 2 can not be read, or it is unplugged between the enumeration and the serial read
+            class UnplugTransport: public SimulatedTransport {
+
+                public:
+
+                    bool unplug = false;
+
+                    explicit UnplugTransport(const Options& options): SimulatedTransport(options) {}
+
+                    std::optional<std::string> getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) override {
+                        if (device.at("port") == 2) {
+                            if (unplug) {
+                                disconnect(1);
+                            }
+                            throw std::runtime_error("libusbErrorName: 'LIBUSB_ERROR_ACCESS'");
+                        }
+                        return SimulatedTransport::getStringDescriptor(device, type);
+                    }
+
+            };
+
+            SimulatedTransport::Options transportOptions = {};
+            transportOptions.deviceCount = 3;
+            std::shared_ptr<UnplugTransport> transport = std::make_shared<UnplugTransport>(transportOptions);
+            DeviceIndex::Options options = {};
+            options.refreshOnMiss = false;
+            DeviceIndex index([&transport]() { return ClientFactory::createShared(true, true, {}, transport); }, options);
+
+            ASSERT_EQ(3, index.refresh());
+            ASSERT_EQ(1, index.findBySerial("SIM1").at("port"));
+            ASSERT_EQ(3, index.findBySerial("SIM3").at("port"));
+            ASSERT_TRUE(index.findBySerial("SIM2").empty());
+            ASSERT_EQ(2, index.findByPortPath("1-2").at("port"));
+            ASSERT_EQ(3, index.findByVendorProduct(transportOptions.vendor, transportOptions.product).size());
+
+            transport->unplug = true;
+
+            ASSERT_EQ(2, index.refresh());
+            ASSERT_TRUE(index.findByPortPath("1-2").empty());
+            ASSERT_EQ(2, index.findByVendorProduct(transportOptions.vendor, transportOptions.product).size());
+
+            // a map without the port path keys, e.g. built by hand, still opens the device
+            std::map<std::string, uint16_t> device = index.findBySerial("SIM3");
+            device.erase("portPath0");
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            client->open(device);
+
+            ASSERT_TRUE(client->isOpen());
+            ASSERT_EQ("SIM3", client->getStringDescriptor(device, StringDescriptor::SERIAL_NUMBER).value_or(""));
+
+            client->close();
+            device["portPath0"] = 1;
+
+            ASSERT_THROW(client->open(device), std::runtime_error);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
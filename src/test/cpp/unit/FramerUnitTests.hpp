@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <span>
+#include <random>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/Framer.hpp"
+
+namespace exqudens::usb {
+
+    class FramerUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "FramerUnitTests";
+
+        protected:
+
+            static void push(Framer& framer, const std::string& value) {
+                framer.push((const uint8_t*) value.data(), value.size());
+            }
+
+            static std::optional<std::string> next(Framer& framer) {
+                std::optional<std::span<const uint8_t>> result = framer.next();
+                if (!result) {
+                    return {};
+                }
+                return std::string(result.value().begin(), result.value().end());
+            }
+
+    };
+
+    TEST_F(FramerUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::mt19937 random(42);
+            std::vector<uint8_t> data(300);
+            for (uint8_t& value : data) {
+                value = (uint8_t) (random() % 8);
+            }
+            for (size_t offset = 0; offset < 40; offset++) {
+                for (size_t size = 0; offset + size <= data.size(); size++) {
+                    const uint8_t* found = (const uint8_t*) std::memchr(data.data() + offset, 7, size);
+                    size_t expected = found == nullptr ? size : (size_t) (found - (data.data() + offset));
+                    ASSERT_EQ(expected, Framer::find(data.data() + offset, size, 7));
+                }
+            }
+
+            Framer::Options options = {};
+            Framer framer(options);
+
+            push(framer, "ABC\nS");
+
+            ASSERT_EQ("ABC", next(framer));
+            ASSERT_FALSE(next(framer));
+
+            push(framer, "D\n\nlast");
+
+            ASSERT_EQ("SD", next(framer));
+            ASSERT_EQ("", next(framer));
+            ASSERT_FALSE(next(framer));
+            ASSERT_EQ(4, framer.getPendingSize());
+
+            options.delimiter = {'\r', '\n'};
+            Framer sentinelFramer(options);
+
+            push(sentinelFramer, "a\rb\r");
+
+            ASSERT_FALSE(next(sentinelFramer));
+
+            push(sentinelFramer, "\nc\r\n");
+
+            ASSERT_EQ("a\rb", next(sentinelFramer));
+            ASSERT_EQ("c", next(sentinelFramer));
+            ASSERT_FALSE(next(sentinelFramer));
+
+            options.maxMessageSize = 8;
+            Framer limitedFramer(options);
+
+            push(limitedFramer, "0123456789");
+
+            ASSERT_THROW(limitedFramer.next(), std::runtime_error);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(FramerUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            Framer::Options options = {};
+            options.lengthSize = 2;
+            options.bigEndian = true;
+            Framer framer(options);
+
+            push(framer, std::string("\x00\x03" "ABC" "\x00", 6));
+
+            ASSERT_EQ("ABC", next(framer));
+            ASSERT_FALSE(next(framer));
+
+            push(framer, std::string("\x02" "SD" "\x00\x00", 5));
+
+            ASSERT_EQ("SD", next(framer));
+            ASSERT_EQ("", next(framer));
+            ASSERT_FALSE(next(framer));
+
+            // packed replies of the simulated echo device, read directly into the receive buffer
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared({});
+            client->open(client->listDevices().front());
+            std::string data = "ABC\nSD\n";
+            client->bulkWrite(std::vector<uint8_t>(data.begin(), data.end()), 1, 1000);
+            Framer clientFramer(client, 0x81, 1000, {});
+            std::span<const uint8_t> message = clientFramer.receive();
+
+            ASSERT_EQ("ABC", std::string(message.begin(), message.end()));
+
+            message = clientFramer.receive();
+
+            ASSERT_EQ("SD", std::string(message.begin(), message.end()));
+            ASSERT_EQ(0, clientFramer.getPendingSize());
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <cstring>
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+#include <libusb.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -12,6 +21,7 @@
 
 #include "TestUtils.hpp"
 #include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/DescriptorCache.hpp"
 
 namespace exqudens::usb {
 
@@ -44,6 +54,27 @@ namespace exqudens::usb {
                 events.emplace_back(event);
             }
 
+            template<typename ENDPOINT>
+            inline static constexpr bool CAN_WRITE = requires(IClient& client, const std::vector<uint8_t>& value) { client.template bulkWrite<ENDPOINT>(value, 0); };
+
+            template<typename ENDPOINT>
+            inline static constexpr bool CAN_READ = requires(IClient& client) { client.template bulkRead<ENDPOINT>(0, 0); };
+
+            class CountingTransport: public SimulatedTransport {
+
+                public:
+
+                    size_t stringReads = 0;
+
+                    explicit CountingTransport(const Options& options): SimulatedTransport(options) {}
+
+                    std::optional<std::string> getStringDescriptor(const std::map<std::string, uint16_t>& device, StringDescriptor type) override {
+                        stringReads++;
+                        return SimulatedTransport::getStringDescriptor(device, type);
+                    }
+
+            };
+
     };
 
     TEST_F(IClientUnitTests, test1) {
@@ -90,4 +121,804 @@ namespace exqudens::usb {
         }
     }
 
+    TEST_F(IClientUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = nullptr;
+            SimulatedTransport::Options options = {};
+            std::vector<std::map<std::string, unsigned short>> devices = {};
+            std::map<std::string, unsigned short> device = {};
+            std::vector<std::string> stackTrace = {};
+            std::string data = "";
+            std::vector<unsigned char> bytes = {};
+            size_t size = 0;
+
+            options.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) {
+                std::vector<uint8_t> result = value;
+                std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+                return result;
+            };
+            client = ClientFactory::createSimulatedShared(true, true, &IClientUnitTests::log, options);
+            devices = client->listDevices();
+            for (size_t i = 0; i < devices.size(); i++) {
+                EXQUDENS_LOG_INFO(LOGGER_ID) << client->toString(devices.at(i));
+                if (devices.at(i).at("vendor") == 0x0484 && devices.at(i).at("product") == 0x5741) {
+                    device = devices.at(i);
+                    break;
+                }
+            }
+            ASSERT_FALSE(device.empty());
+
+            client->open(device);
+            ASSERT_TRUE(client->isOpen());
+            ASSERT_TRUE(device == client->getDevice());
+
+            try {
+                bytes = client->bulkRead(1, 10, 1024);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "stackTrace.size: " << stackTrace.size();
+
+            ASSERT_TRUE(bytes.empty());
+            ASSERT_FALSE(stackTrace.empty());
+            ASSERT_TRUE(stackTrace.at(0).ends_with("libusbErrorName: 'LIBUSB_ERROR_TIMEOUT'"));
+
+            data = "abc";
+            bytes = std::vector<unsigned char>(data.begin(), data.end());
+            size = client->bulkWrite(bytes, 1);
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "size: " << size;
+
+            ASSERT_EQ(3, size);
+
+            bytes = client->bulkRead(1, 10, 1024);
+            data = std::string(bytes.begin(), bytes.end());
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "data: '" << data << "'";
+
+            ASSERT_EQ(std::string("ABC"), data);
+
+            client->close();
+            ASSERT_FALSE(client->isOpen());
+            ASSERT_TRUE(client->getDevice().empty());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test3) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = nullptr;
+            SimulatedTransport::Options options = {};
+            std::vector<std::map<std::string, unsigned short>> devices = {};
+            std::vector<std::string> stackTrace = {};
+
+            options.deviceCount = 8;
+            client = ClientFactory::createSimulatedShared(options);
+            devices = client->listDevices();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "devices.size: " << devices.size();
+
+            ASSERT_EQ(8, devices.size());
+
+            try {
+                client->open({});
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_FALSE(stackTrace.empty());
+            ASSERT_FALSE(client->isOpen());
+
+            client->open(devices.back());
+            ASSERT_TRUE(client->isOpen());
+            ASSERT_TRUE(devices.back() == client->getDevice());
+
+            client->close();
+            ASSERT_FALSE(client->isOpen());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test4) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = nullptr;
+            std::vector<std::string> stackTrace = {};
+            std::string data = "";
+            size_t size = 0;
+
+            client = ClientFactory::createSimulatedShared({});
+
+            try {
+                Buffer buffer = client->allocateBuffer(64);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_FALSE(stackTrace.empty());
+
+            client->open(client->listDevices().front());
+
+            Buffer output = client->allocateBuffer(64);
+            Buffer input = client->allocateBuffer(64);
+
+            ASSERT_TRUE(output.getCapacity() >= 64);
+            ASSERT_TRUE(input.getCapacity() >= 64);
+
+            data = "abc";
+            std::copy(data.begin(), data.end(), output.getData());
+            output.setSize(data.size());
+            size = client->bulkWrite(output, 1, 10);
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "size: " << size;
+
+            ASSERT_EQ(3, size);
+
+            size = client->bulkRead(input, 1, 10);
+            data = std::string(input.getData(), input.getData() + input.getSize());
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "data: '" << data << "'";
+
+            ASSERT_EQ(3, size);
+            ASSERT_EQ(std::string("abc"), data);
+
+            Buffer moved = std::move(input);
+
+            ASSERT_TRUE(input.getData() == nullptr);
+            ASSERT_EQ(3, moved.getSize());
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test5) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<SimulatedTransport> transport = std::make_shared<SimulatedTransport>();
+            std::shared_ptr<IClient> client = nullptr;
+            std::map<std::string, unsigned short> device = {};
+            std::vector<std::string> stackTrace = {};
+            std::string data = "";
+            std::vector<unsigned char> bytes = {};
+
+            client = ClientFactory::createShared(true, true, &IClientUnitTests::log, transport);
+            client->setReconnect(1000);
+            client->open(client->listDevices().front());
+            device = client->getDevice();
+
+            transport->disconnect(0);
+
+            ASSERT_TRUE(client->listDevices().empty());
+
+            std::thread plug([&transport]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                transport->connect(0);
+            });
+            data = "abc";
+            client->bulkWrite(std::vector<unsigned char>(data.begin(), data.end()), 1, 10);
+            plug.join();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "device: " << client->toString(client->getDevice());
+
+            ASSERT_FALSE(client->isReconnecting());
+            ASSERT_EQ(device.at("port"), client->getDevice().at("port"));
+            ASSERT_NE(device.at("address"), client->getDevice().at("address"));
+
+            bytes = client->bulkRead(1, 10, 64);
+
+            ASSERT_EQ(std::string("abc"), std::string(bytes.begin(), bytes.end()));
+
+            client->setReconnect(0);
+            transport->disconnect(0);
+
+            try {
+                client->bulkRead(1, 10, 64);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_FALSE(stackTrace.empty());
+            ASSERT_TRUE(client->isReconnecting());
+            ASSERT_FALSE(client->isOpen());
+
+            transport->connect(0);
+            client->bulkWrite(std::vector<unsigned char>(data.begin(), data.end()), 1, 10);
+
+            ASSERT_FALSE(client->isReconnecting());
+            ASSERT_TRUE(client->isOpen());
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test6) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = nullptr;
+            std::shared_ptr<CancellationToken> token = std::make_shared<CancellationToken>();
+            std::vector<std::string> stackTrace = {};
+            std::string data = "abc";
+            std::vector<unsigned char> bytes = {};
+            std::chrono::steady_clock::time_point start = {};
+            std::chrono::milliseconds elapsed = {};
+
+            client = ClientFactory::createSimulatedShared({});
+            client->open(client->listDevices().front());
+
+            client->bulkWrite(std::vector<unsigned char>(data.begin(), data.end()), 1, std::chrono::steady_clock::now() + std::chrono::seconds(1), nullptr);
+            bytes = client->bulkRead(1, std::chrono::steady_clock::now() + std::chrono::seconds(1), 64, token);
+
+            ASSERT_EQ(data, std::string(bytes.begin(), bytes.end()));
+
+            try {
+                client->bulkRead(1, std::chrono::steady_clock::now() - std::chrono::milliseconds(1), 64, nullptr);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_FALSE(stackTrace.empty());
+            ASSERT_TRUE(std::ranges::any_of(stackTrace, [](const std::string& line) { return line.find("LIBUSB_ERROR_TIMEOUT") != std::string::npos; }));
+
+            stackTrace = {};
+            start = std::chrono::steady_clock::now();
+            std::thread canceller([&token]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                token->cancel();
+            });
+            try {
+                client->bulkRead(1, std::chrono::steady_clock::now() + std::chrono::seconds(10), 64, token);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+            canceller.join();
+            elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "elapsed: " << elapsed.count() << " ms";
+
+            ASSERT_TRUE(std::ranges::any_of(stackTrace, [](const std::string& line) { return line.find("LIBUSB_ERROR_INTERRUPTED") != std::string::npos; }));
+            ASSERT_TRUE(elapsed < std::chrono::seconds(5));
+            ASSERT_TRUE(token->isCancelled());
+
+            stackTrace = {};
+            try {
+                client->bulkWrite(std::vector<unsigned char>(data.begin(), data.end()), 1, std::chrono::steady_clock::now() + std::chrono::seconds(1), token);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_FALSE(stackTrace.empty());
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test7) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = nullptr;
+            SimulatedTransport::Options options = {};
+            DeviceFilter filter = {};
+            std::vector<std::map<std::string, unsigned short>> devices = {};
+
+            options.deviceCount = 300;
+            client = ClientFactory::createSimulatedShared(options);
+
+            ASSERT_EQ(300, client->listDevices(filter).size());
+
+            filter.vendors = {0x0484};
+            filter.products = {0x5741, 0x1234};
+            filter.bus = 1;
+            filter.deviceClass = 0xFF;
+
+            ASSERT_EQ(300, client->listDevices(filter).size());
+
+            filter.portPath = {7};
+            devices = client->listDevices(filter);
+
+            ASSERT_EQ(1, devices.size());
+            ASSERT_EQ(7, devices.front().at("port"));
+
+            filter.portPath = {};
+            filter.serial = "SIM42";
+            devices = client->listDevices(filter);
+
+            ASSERT_EQ(1, devices.size());
+            ASSERT_EQ(42, devices.front().at("port"));
+
+            filter = {};
+            filter.vendors = {0x1234};
+
+            ASSERT_TRUE(client->listDevices(filter).empty());
+
+            filter = {};
+            filter.deviceClass = 0x03;
+
+            ASSERT_TRUE(client->listDevices(filter).empty());
+
+            filter = {};
+            filter.bus = 2;
+
+            ASSERT_TRUE(client->listDevices(filter).empty());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test8) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<SimulatedTransport> transport = std::make_shared<SimulatedTransport>();
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            std::vector<std::string> stackTrace = {};
+            std::string data = "abc";
+            std::vector<unsigned char> bytes = {};
+
+            client->open(client->listDevices().front());
+
+            ASSERT_EQ(0, transport->getSpinBudget());
+
+            client->bulkWrite(std::vector<unsigned char>(data.begin(), data.end()), 1, 1000);
+            client->bulkRead(1, 1000, 64);
+
+            ASSERT_EQ(0, transport->getPollStats().spinHits);
+            ASSERT_EQ(0, transport->getPollStats().spinMisses);
+
+            transport->setSpinBudget(1000);
+
+            ASSERT_EQ(1000, transport->getSpinBudget());
+
+            std::thread writer([&client, &data]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                client->bulkWrite(std::vector<unsigned char>(data.begin(), data.end()), 1, 1000);
+            });
+            bytes = client->bulkRead(1, 1000, 64);
+            writer.join();
+
+            ASSERT_EQ(data, std::string(bytes.begin(), bytes.end()));
+            ASSERT_EQ(1, transport->getPollStats().spinHits + transport->getPollStats().spinMisses);
+
+            try {
+                client->bulkRead(1, 10, 64);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_TRUE(std::ranges::any_of(stackTrace, [](const std::string& line) { return line.find("LIBUSB_ERROR_TIMEOUT") != std::string::npos; }));
+            ASSERT_TRUE(transport->getPollStats().spinMisses >= 1);
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test9) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            SimulatedTransport::Options options = {};
+            options.deviceCount = 100;
+            std::shared_ptr<CountingTransport> transport = std::make_shared<CountingTransport>(options);
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            DeviceFilter filter = {};
+            std::vector<std::map<std::string, unsigned short>> devices = client->listDevices();
+
+            ASSERT_EQ("exqudens", client->getStringDescriptor(devices.at(4), StringDescriptor::MANUFACTURER));
+            ASSERT_EQ("Simulated Device", client->getStringDescriptor(devices.at(4), StringDescriptor::PRODUCT));
+            ASSERT_EQ("SIM5", client->getStringDescriptor(devices.at(4), StringDescriptor::SERIAL_NUMBER));
+            ASSERT_EQ(3, transport->stringReads);
+
+            ASSERT_EQ("SIM5", client->getStringDescriptor(devices.at(4), StringDescriptor::SERIAL_NUMBER));
+            ASSERT_EQ(3, transport->stringReads);
+
+            filter.serial = "SIM42";
+            devices = client->listDevices(filter);
+
+            ASSERT_EQ(1, devices.size());
+            ASSERT_EQ(42, devices.front().at("port"));
+            ASSERT_EQ(102, transport->stringReads);
+
+            devices = client->listDevices(filter);
+
+            ASSERT_EQ(1, devices.size());
+            ASSERT_EQ(102, transport->stringReads);
+
+            // re-enumeration gives a new address, the strings are read again
+            transport->disconnect(41);
+            client->listDevices();
+            transport->connect(41);
+            devices = client->listDevices(filter);
+
+            ASSERT_EQ(1, devices.size());
+            ASSERT_EQ(103, transport->stringReads);
+
+            filter.serial = "SIM1000";
+
+            ASSERT_TRUE(client->listDevices(filter).empty());
+            ASSERT_EQ(103, transport->stringReads);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test10) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::filesystem::path outputDir = TestUtils::getTestOutputDir(testGroup, testCase).value();
+            std::filesystem::remove_all(outputDir);
+            std::filesystem::create_directories(outputDir);
+            std::string path = (outputDir / "descriptors.bin").generic_string();
+            SimulatedTransport::Options options = {};
+            options.deviceCount = 100;
+            std::shared_ptr<CountingTransport> transport = std::make_shared<CountingTransport>(options);
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            DeviceFilter filter = {};
+            std::vector<std::string> stackTrace = {};
+
+            ASSERT_EQ(0, client->loadDescriptorCache(path));
+
+            filter.serial = "SIM42";
+
+            ASSERT_EQ(1, client->listDevices(filter).size());
+            ASSERT_EQ(100, transport->stringReads);
+            ASSERT_EQ("exqudens", client->getStringDescriptor(client->listDevices().front(), StringDescriptor::MANUFACTURER));
+
+            client->saveDescriptorCache(path);
+
+            ASSERT_TRUE(std::filesystem::exists(path));
+            ASSERT_EQ(1, std::distance(std::filesystem::directory_iterator(outputDir), std::filesystem::directory_iterator()));
+
+            // concurrent writers never share a temporary file, the last rename wins with a complete file
+            std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> saved = DescriptorCache::read(path);
+            std::vector<std::thread> writers = {};
+            for (size_t i = 0; i < 4; i++) {
+                writers.emplace_back([&path, &saved]() {
+                    for (size_t j = 0; j < 10; j++) {
+                        DescriptorCache::write(path, saved);
+                    }
+                });
+            }
+            for (std::thread& writer : writers) {
+                writer.join();
+            }
+
+            ASSERT_EQ(saved, DescriptorCache::read(path));
+            ASSERT_EQ(1, std::distance(std::filesystem::directory_iterator(outputDir), std::filesystem::directory_iterator()));
+
+            // restarted service: the same devices are still attached, one of them re-enumerated meanwhile
+            transport = std::make_shared<CountingTransport>(options);
+            client = ClientFactory::createShared(true, true, {}, transport);
+            transport->disconnect(9);
+            transport->connect(9);
+
+            ASSERT_EQ(99, client->loadDescriptorCache(path));
+
+            ASSERT_EQ(1, client->listDevices(filter).size());
+            ASSERT_EQ("exqudens", client->getStringDescriptor(client->listDevices().front(), StringDescriptor::MANUFACTURER));
+            ASSERT_EQ(1, transport->stringReads);
+
+            // a file written before the port path keys still hits
+            std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> cache = DescriptorCache::read(path);
+            std::map<std::map<std::string, uint16_t>, std::map<StringDescriptor, std::optional<std::string>>> oldCache = {};
+            for (const auto& [device, strings] : cache) {
+                std::map<std::string, uint16_t> oldDevice = device;
+                std::erase_if(oldDevice, [](const auto& entry) { return entry.first.starts_with("portPath"); });
+                oldCache[oldDevice] = strings;
+            }
+            DescriptorCache::write(path, oldCache);
+            transport = std::make_shared<CountingTransport>(options);
+            client = ClientFactory::createShared(true, true, {}, transport);
+
+            ASSERT_EQ(100, client->loadDescriptorCache(path));
+
+            std::ofstream(path, std::ios::binary | std::ios::app) << "garbage";
+            try {
+                client->loadDescriptorCache(path);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_TRUE(std::ranges::any_of(stackTrace, [](const std::string& line) { return line.find("trailing data") != std::string::npos; }));
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test11) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            using Write = Endpoint<1, Out, Bulk>;
+            using Read = Endpoint<1, In, Bulk>;
+
+            static_assert(Write::ADDRESS == 0x01);
+            static_assert(Read::ADDRESS == 0x81);
+            static_assert(Endpoint<15, In, Interrupt>::ADDRESS == 0x8F);
+            static_assert(CAN_WRITE<Write>);
+            static_assert(!CAN_WRITE<Read>);
+            static_assert(CAN_READ<Read>);
+            static_assert(!CAN_READ<Write>);
+            static_assert(!CAN_READ<Endpoint<1, In, Interrupt>>);
+
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared({});
+            std::string data = "abc";
+            std::vector<unsigned char> bytes = {};
+
+            client->open(client->listDevices().front());
+
+            ASSERT_EQ(3, client->bulkWrite<Write>(std::vector<unsigned char>(data.begin(), data.end()), 1000));
+
+            bytes = client->bulkRead<Read>(1000, 64);
+
+            ASSERT_EQ(data, std::string(bytes.begin(), bytes.end()));
+
+            Buffer buffer = client->allocateBuffer(64);
+            std::memcpy(buffer.getData(), data.data(), data.size());
+            buffer.setSize(data.size());
+
+            ASSERT_EQ(3, client->bulkWrite<Write>(buffer, 1000));
+            ASSERT_EQ(3, client->bulkRead<Read>(buffer, 1000));
+            ASSERT_EQ(data, std::string((const char*) buffer.getData(), buffer.getSize()));
+
+            buffer.release();
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test12) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            class OpenCountingTransport: public SimulatedTransport {
+
+                public:
+
+                    std::atomic<size_t> opens = 0;
+
+                    explicit OpenCountingTransport(const Options& options): SimulatedTransport(options) {}
+
+                    void open(const std::map<std::string, uint16_t>& value, int32_t interfaceNumber, const std::optional<bool>& detachKernelDriver) override {
+                        SimulatedTransport::open(value, interfaceNumber, detachKernelDriver);
+                        opens++;
+                    }
+
+            };
+
+            std::shared_ptr<OpenCountingTransport> transport = std::make_shared<OpenCountingTransport>(SimulatedTransport::Options {});
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            std::string data = "abc";
+            std::vector<std::thread> threads = {};
+            std::atomic<size_t> written = 0;
+
+            client->setReconnect(1000);
+            client->open(client->listDevices().front());
+            transport->disconnect(0);
+
+            // every writer loses the device, only one of them reopens it
+            for (size_t i = 0; i < 4; i++) {
+                threads.emplace_back([&client, &data, &written]() {
+                    written += client->bulkWrite(std::vector<unsigned char>(data.begin(), data.end()), 1, 10);
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            transport->connect(0);
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            ASSERT_EQ(12, written);
+            ASSERT_EQ(2, transport->opens);
+            ASSERT_FALSE(client->isReconnecting());
+            ASSERT_TRUE(client->isOpen());
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test13) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<SimulatedTransport> transport = std::make_shared<SimulatedTransport>();
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            std::shared_ptr<CancellationToken> token = std::make_shared<CancellationToken>();
+            std::vector<unsigned char> value = {1, 2, 3};
+            std::vector<std::string> stackTrace = {};
+
+            client->setReconnect(5000);
+            client->open(client->listDevices().front());
+            transport->disconnect(0);
+
+            // the deadline bounds the reconnect window
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            try {
+                client->bulkWrite(value, 1, start + std::chrono::milliseconds(50), token);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+            std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+            ASSERT_FALSE(stackTrace.empty());
+            ASSERT_TRUE(client->isReconnecting());
+            ASSERT_LT(elapsed, std::chrono::milliseconds(1000));
+
+            // the token interrupts it
+            stackTrace = {};
+            std::thread canceller([&token]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                token->cancel();
+            });
+            start = std::chrono::steady_clock::now();
+            try {
+                client->bulkWrite(value, 1, start + std::chrono::milliseconds(5000), token);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+            elapsed = std::chrono::steady_clock::now() - start;
+            canceller.join();
+
+            ASSERT_FALSE(stackTrace.empty());
+            ASSERT_LT(elapsed, std::chrono::milliseconds(1000));
+
+            transport->connect(0);
+            client->bulkWrite(value, 1, std::chrono::steady_clock::now() + std::chrono::milliseconds(1000), std::make_shared<CancellationToken>());
+
+            ASSERT_FALSE(client->isReconnecting());
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(IClientUnitTests, test14) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            class GlitchTransport: public SimulatedTransport {
+
+                public:
+
+                    std::atomic<bool> glitch = false;
+                    std::atomic<size_t> opens = 0;
+
+                    explicit GlitchTransport(const Options& options): SimulatedTransport(options) {}
+
+                    void open(const std::map<std::string, uint16_t>& value, int32_t interfaceNumber, const std::optional<bool>& detachKernelDriver) override {
+                        SimulatedTransport::open(value, interfaceNumber, detachKernelDriver);
+                        opens++;
+                    }
+
+                    int bulkTransfer(uint8_t endpoint, uint8_t* data, int32_t length, int32_t* transferred, uint32_t timeout, const std::shared_ptr<CancellationToken>& token) override {
+                        // the write loses the device once, the blocked read is not woken by it
+                        if (!(endpoint & LIBUSB_ENDPOINT_IN) && glitch.exchange(false)) {
+                            *transferred = 0;
+                            return LIBUSB_ERROR_NO_DEVICE;
+                        }
+                        return SimulatedTransport::bulkTransfer(endpoint, data, length, transferred, timeout, token);
+                    }
+
+            };
+
+            std::shared_ptr<GlitchTransport> transport = std::make_shared<GlitchTransport>(SimulatedTransport::Options {});
+            std::shared_ptr<IClient> client = ClientFactory::createShared(true, true, {}, transport);
+            std::vector<unsigned char> value = {1, 2, 3};
+            std::vector<uint8_t> received = {};
+
+            client->setReconnect(1000);
+            client->open(client->listDevices().front());
+
+            // the reader is blocked in the transport while the writer reconnects, it retries on the new connection
+            std::thread reader([&client, &received]() {
+                received = client->bulkRead(0x81, 5000, 3);
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            transport->glitch = true;
+            client->bulkWrite(value, 1, 1000);
+            reader.join();
+
+            ASSERT_EQ(2, transport->opens);
+            ASSERT_EQ(std::vector<uint8_t>(value.begin(), value.end()), received);
+            ASSERT_FALSE(client->isReconnecting());
+            ASSERT_TRUE(client->isOpen());
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
 }
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/LibusbTransferPool.hpp"
+
+namespace exqudens::usb {
+
+    class LibusbTransferPoolUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "LibusbTransferPoolUnitTests";
+
+        protected:
+
+            struct Calls {
+                size_t allocTransfer = 0;
+                size_t freeTransfer = 0;
+                size_t devMemAlloc = 0;
+                size_t devMemFree = 0;
+                size_t close = 0;
+            };
+
+            // counts the calls, device memory is heap memory unless 'deviceMemory' is off
+            static LibusbTransferPool::Functions toFunctions(Calls& calls, bool deviceMemory) {
+                LibusbTransferPool::Functions result = {};
+                result.allocTransfer = [&calls]() {
+                    calls.allocTransfer++;
+                    return static_cast<libusb_transfer*>(std::calloc(1, sizeof(libusb_transfer)));
+                };
+                result.freeTransfer = [&calls](libusb_transfer* transfer) {
+                    calls.freeTransfer++;
+                    std::free(transfer);
+                };
+                result.devMemAlloc = [&calls, deviceMemory](libusb_device_handle*, size_t length) {
+                    calls.devMemAlloc++;
+                    return deviceMemory ? static_cast<uint8_t*>(std::malloc(length)) : nullptr;
+                };
+                result.devMemFree = [&calls](libusb_device_handle*, uint8_t* data, size_t) {
+                    calls.devMemFree++;
+                    std::free(data);
+                    return 0;
+                };
+                result.close = [&calls](libusb_device_handle*) {
+                    calls.close++;
+                };
+                return result;
+            }
+
+            static libusb_device_handle* toHandle() {
+                static int value = 0;
+                return reinterpret_cast<libusb_device_handle*>(&value);
+            }
+
+    };
+
+    TEST_F(LibusbTransferPoolUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            Calls calls = {};
+            std::shared_ptr<LibusbTransferPool> pool = std::make_shared<LibusbTransferPool>(toHandle(), toFunctions(calls, true));
+
+            // released transfers are reused
+            libusb_transfer* transfer1 = pool->acquireTransfer();
+            libusb_transfer* transfer2 = pool->acquireTransfer();
+            transfer1->user_data = transfer2;
+            pool->releaseTransfer(transfer1);
+
+            ASSERT_EQ(transfer1, pool->acquireTransfer());
+            ASSERT_EQ(nullptr, transfer1->user_data);
+            ASSERT_EQ(2, calls.allocTransfer);
+
+            pool->releaseTransfer(transfer1);
+            pool->releaseTransfer(transfer2);
+
+            // released buffers are reused per rounded capacity
+            Buffer buffer = pool->acquireBuffer(100);
+            uint8_t* data = buffer.getData();
+
+            ASSERT_TRUE(buffer.isDeviceMemory());
+            ASSERT_EQ(LibusbTransferPool::MIN_BUFFER_CAPACITY, buffer.getCapacity());
+
+            buffer.release();
+            buffer = pool->acquireBuffer(512);
+
+            ASSERT_EQ(data, buffer.getData());
+            ASSERT_EQ(1, calls.devMemAlloc);
+            ASSERT_EQ(2048, pool->acquireBuffer(2000).getCapacity());
+
+            // the buffer outlives the pool, the handle is closed once it is released
+            pool = nullptr;
+
+            ASSERT_EQ(0, calls.close);
+
+            buffer.getData()[0] = 1;
+            buffer.release();
+
+            ASSERT_EQ(1, calls.close);
+            ASSERT_EQ(2, calls.freeTransfer);
+            ASSERT_EQ(2, calls.devMemFree);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(LibusbTransferPoolUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            // no device memory: the first failed allocation falls back to the heap for good
+            Calls calls = {};
+            std::shared_ptr<LibusbTransferPool> pool = std::make_shared<LibusbTransferPool>(toHandle(), toFunctions(calls, false));
+            std::vector<Buffer> buffers = {};
+            for (size_t i = 0; i < 3; i++) {
+                buffers.emplace_back(pool->acquireBuffer(4096));
+            }
+
+            ASSERT_FALSE(buffers.front().isDeviceMemory());
+            ASSERT_EQ(1, calls.devMemAlloc);
+
+            buffers.clear();
+            pool = nullptr;
+
+            ASSERT_EQ(1, calls.close);
+            ASSERT_EQ(0, calls.devMemFree);
+
+            ASSERT_THROW(LibusbTransferPool(nullptr, toFunctions(calls, false)), std::runtime_error);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "LoadGenerator.hpp"
+
+namespace exqudens::usb {
+
+    class LoadGeneratorUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "LoadGeneratorUnitTests";
+
+    };
+
+    TEST_F(LoadGeneratorUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared({});
+            client->open(client->listDevices().front());
+            LoadGenerator generator(client);
+            LoadGenerator::Options options = {};
+            options.size = 64;
+            options.count = 100;
+
+            LoadGenerator::Result result = generator.run(options);
+
+            ASSERT_EQ(LoadGenerator::Workload::ECHO, result.workload);
+            ASSERT_EQ(100, result.transfers);
+            ASSERT_EQ(6400, result.bytes);
+            ASSERT_LE(result.min, result.p50);
+            ASSERT_LE(result.p50, result.max);
+            ASSERT_GT(result.transfersPerSecond, 0);
+
+            // the writer and the reader keep up to 'depth' messages in flight
+            options.depth = 4;
+            result = generator.run(options);
+
+            ASSERT_EQ(100, result.transfers);
+            ASSERT_EQ(4, result.depth);
+
+            std::vector<LoadGenerator::Result> results = generator.sweepSize(options, {16, 512});
+
+            ASSERT_EQ(2, results.size());
+            ASSERT_EQ(16, results.at(0).size);
+            ASSERT_EQ(100 * 512, results.at(1).bytes);
+
+            results = generator.sweepDepth(options, {1, 2});
+
+            ASSERT_EQ(2, results.size());
+            ASSERT_EQ(2, results.at(1).depth);
+
+            std::string json = LoadGenerator::toJson(results);
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "json: " << json;
+
+            ASSERT_EQ(0, json.find("[\n  {\"workload\": \"echo\", \"size\": 64, \"depth\": 1, \"transfers\": 100, \"bytes\": 6400, "));
+            ASSERT_THAT(json, testing::HasSubstr("\"depth\": 2, "));
+            ASSERT_THAT(json, testing::HasSubstr("\"latencyMicroseconds\": {\"min\": "));
+            ASSERT_THAT(LoadGenerator::toText(results), testing::HasSubstr("p99.9 us"));
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(LoadGeneratorUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            SimulatedTransport::Options transportOptions = {};
+            transportOptions.transform = [](uint8_t endpoint, const std::vector<uint8_t>& value) { return std::vector<uint8_t>(); };
+            transportOptions.source = [](uint8_t endpoint, int32_t length) { return std::vector<uint8_t>((size_t) length, 0xA5); };
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(transportOptions);
+            client->open(client->listDevices().front());
+            LoadGenerator generator(client);
+            LoadGenerator::Options options = {};
+            options.size = 128;
+            options.depth = 2;
+            options.count = 50;
+
+            options.workload = LoadGenerator::toWorkload("write");
+            LoadGenerator::Result result = generator.run(options);
+
+            ASSERT_EQ(LoadGenerator::Workload::WRITE, result.workload);
+            ASSERT_EQ(50, result.transfers);
+            ASSERT_EQ(50 * 128, result.bytes);
+
+            options.workload = LoadGenerator::toWorkload("read");
+            result = generator.run(options);
+
+            ASSERT_EQ(50, result.transfers);
+            ASSERT_EQ(50 * 128, result.bytes);
+
+            // a run limited by duration only
+            options.count = 0;
+            options.duration = std::chrono::milliseconds(20);
+            result = generator.run(options);
+
+            ASSERT_GT(result.transfers, 0);
+            ASSERT_GE(result.seconds, 0.02);
+
+            options.duration = std::chrono::milliseconds(0);
+
+            ASSERT_THROW(generator.run(options), std::runtime_error);
+            ASSERT_THROW(LoadGenerator::toWorkload("flood"), std::runtime_error);
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
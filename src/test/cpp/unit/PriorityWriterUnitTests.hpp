@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/PriorityWriter.hpp"
+
+namespace exqudens::usb {
+
+    class PriorityWriterUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "PriorityWriterUnitTests";
+
+        protected:
+
+            /*!
+            * Simulated device recording the first byte of every written message,
+            * the first write blocks until 'release' so the following submissions queue up.
+            */
+            struct Device {
+                std::mutex mutex = {};
+                std::condition_variable condition = {};
+                std::vector<uint8_t> order = {};
+                std::atomic<bool> entered = false;
+                bool released = false;
+                std::shared_ptr<IClient> client = nullptr;
+
+                Device() {
+                    SimulatedTransport::Options options = {};
+                    options.transform = [this](uint8_t endpoint, const std::vector<uint8_t>& value) {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        order.emplace_back(value.front());
+                        entered = true;
+                        condition.wait(lock, [this]() { return released; });
+                        return std::vector<uint8_t>();
+                    };
+                    client = ClientFactory::createSimulatedShared(options);
+                    client->open(client->listDevices().front());
+                }
+
+                void waitEntered() {
+                    while (!entered) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                void release() {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        released = true;
+                    }
+                    condition.notify_all();
+                }
+            };
+
+    };
+
+    TEST_F(PriorityWriterUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            Device device;
+            PriorityWriter writer(device.client, 0x01);
+            std::atomic<size_t> callbacks = 0;
+            auto callback = [&callbacks](std::exception_ptr error) {
+                if (!error) {
+                    callbacks++;
+                }
+            };
+
+            writer.submit({'D', 0, 0, 0}, PriorityWriter::Priority::LOW, callback);
+            device.waitEntered();
+            writer.submit({'d'}, PriorityWriter::Priority::LOW, callback);
+            writer.submit({'n'}, PriorityWriter::Priority::NORMAL, callback);
+            writer.submit({'C'}, PriorityWriter::Priority::HIGH, callback);
+            writer.submit({'c'}, PriorityWriter::Priority::HIGH, callback);
+
+            std::map<PriorityWriter::Priority, PriorityWriter::ClassMetrics> metrics = writer.getMetrics();
+
+            ASSERT_EQ(2, metrics.at(PriorityWriter::Priority::HIGH).queueDepth);
+            ASSERT_EQ(1, metrics.at(PriorityWriter::Priority::NORMAL).queueDepth);
+            ASSERT_EQ(2, metrics.at(PriorityWriter::Priority::LOW).queueDepth);
+
+            device.release();
+            writer.flush();
+
+            // the in-flight data message completes, then the commands bypass the queued data
+            ASSERT_EQ(std::vector<uint8_t>({'D', 'C', 'c', 'n', 'd'}), device.order);
+            ASSERT_EQ(5, callbacks);
+
+            metrics = writer.getMetrics();
+
+            ASSERT_EQ(0, metrics.at(PriorityWriter::Priority::HIGH).queueDepth);
+            ASSERT_EQ(2, metrics.at(PriorityWriter::Priority::HIGH).maxQueueDepth);
+            ASSERT_EQ(2, metrics.at(PriorityWriter::Priority::HIGH).completed);
+            ASSERT_EQ(1, metrics.at(PriorityWriter::Priority::NORMAL).completed);
+            ASSERT_EQ(2, metrics.at(PriorityWriter::Priority::LOW).completed);
+            ASSERT_GE(metrics.at(PriorityWriter::Priority::LOW).maxWait, metrics.at(PriorityWriter::Priority::HIGH).maxWait);
+
+            device.client->close();
+            writer.submit({'x'}, PriorityWriter::Priority::HIGH);
+
+            ASSERT_THROW(writer.flush(), std::runtime_error);
+            ASSERT_EQ(1, writer.getMetrics().at(PriorityWriter::Priority::HIGH).failed);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(PriorityWriterUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            Device device;
+            PriorityWriter::Options options = {};
+            options.starvationLimit = 2;
+            options.chunkSize = 2;
+            PriorityWriter writer(device.client, 0x01, options);
+
+            writer.submit({'A', 'a', 'a', 'a'}, PriorityWriter::Priority::HIGH);
+            device.waitEntered();
+            writer.submit({'L'}, PriorityWriter::Priority::LOW);
+            writer.submit({'B'}, PriorityWriter::Priority::HIGH);
+            writer.submit({'C'}, PriorityWriter::Priority::HIGH);
+            writer.submit({'D'}, PriorityWriter::Priority::HIGH);
+            device.release();
+            writer.flush();
+
+            // the low priority message is passed over twice ('A' second chunk, 'B'), then goes first once
+            ASSERT_EQ(std::vector<uint8_t>({'A', 'a', 'B', 'L', 'C', 'D'}), device.order);
+
+            device.client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(PriorityWriterUnitTests, test3) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            Device device;
+            PriorityWriter::Options options = {};
+            options.starvationLimit = 2;
+            options.chunkSize = 2;
+            PriorityWriter writer(device.client, 0x01, options);
+
+            writer.submit({'A', 'a', 'a', 'a'}, PriorityWriter::Priority::HIGH);
+            device.waitEntered();
+            writer.submit({'L', 'L', 'l', 'l', 'l', 'l'}, PriorityWriter::Priority::LOW);
+            for (uint8_t value : {'B', 'C', 'D', 'E', 'F'}) {
+                writer.submit({value}, PriorityWriter::Priority::HIGH);
+            }
+            device.release();
+            writer.flush();
+
+            // a starved chunked message goes ahead for one chunk at a time, not until it is fully sent
+            ASSERT_EQ(std::vector<uint8_t>({'A', 'a', 'B', 'L', 'C', 'D', 'l', 'E', 'F', 'l'}), device.order);
+
+            device.client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
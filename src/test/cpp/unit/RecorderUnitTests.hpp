@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/Recorder.hpp"
+
+namespace exqudens::usb {
+
+    class RecorderUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "RecorderUnitTests";
+
+    };
+
+    TEST_F(RecorderUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::filesystem::path outputDir = TestUtils::getTestOutputDir(testGroup, testCase).value();
+            std::filesystem::remove_all(outputDir);
+            uint8_t next = 0;
+            SimulatedTransport::Options transportOptions = {};
+            // a stream of counting bytes, every transfer returns up to 1000 of them
+            transportOptions.source = [&next](uint8_t endpoint, int32_t length) {
+                std::vector<uint8_t> result(std::min(length, 1000));
+                for (uint8_t& value : result) {
+                    value = next++;
+                }
+                return result;
+            };
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(transportOptions);
+            client->open(client->listDevices().front());
+            Recorder::Options options = {};
+            options.directory = outputDir.generic_string();
+            options.bufferSize = 4096;
+            options.bufferCount = 4;
+            options.fileSize = 16384;
+            Recorder recorder(client, 0x81, options);
+
+            recorder.start();
+
+            ASSERT_TRUE(recorder.isRunning());
+
+            while (recorder.getStats().bytesRead < 100000) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            recorder.stop();
+
+            ASSERT_FALSE(recorder.isRunning());
+
+            Recorder::Stats stats = recorder.getStats();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "bytesRead: " << stats.bytesRead << " transferCount: " << stats.transferCount << " overrunCount: " << stats.overrunCount << " files: " << stats.files.size();
+
+            ASSERT_EQ(stats.bytesRead, stats.bytesWritten);
+            ASSERT_TRUE(stats.files.size() > 1);
+            ASSERT_EQ("capture-000000.bin", std::filesystem::path(stats.files.front()).filename().string());
+
+            uint8_t expected = 0;
+            uint64_t size = 0;
+            for (const std::string& file : stats.files) {
+                std::vector<char> bytes = TestUtils::readFileBytes(file);
+                ASSERT_TRUE(bytes.size() <= options.fileSize);
+                for (char value : bytes) {
+                    ASSERT_EQ(expected++, (uint8_t) value);
+                }
+                size += bytes.size();
+            }
+
+            ASSERT_EQ(stats.bytesWritten, size);
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
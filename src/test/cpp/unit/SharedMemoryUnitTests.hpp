@@ -0,0 +1,339 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/SharedMemoryRing.hpp"
+#include "exqudens/usb/SharedMemoryServer.hpp"
+
+namespace exqudens::usb {
+
+    class SharedMemoryUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "SharedMemoryUnitTests";
+
+        protected:
+
+            static std::string toUniqueName() {
+                return "/exqudens-usb-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+            }
+
+    };
+
+#if defined(__linux__)
+
+    TEST_F(SharedMemoryUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::string name = toUniqueName();
+            SharedMemoryRing owner(name, 256);
+            SharedMemoryRing other(name);
+            std::vector<uint8_t> data(128, 0);
+
+            ASSERT_EQ(256, other.getCapacity());
+            ASSERT_EQ(120, other.getMaxRecordSize());
+
+            // queue: records of 48 bytes (8 header + 40 data), the second batch wraps behind a padding record
+            for (uint8_t i = 0; i < 5; i++) {
+                std::vector<uint8_t> value(40, i);
+                ASSERT_TRUE(owner.push(value.data(), value.size(), i, 1000));
+                std::optional<SharedMemoryRing::Record> record = other.pop(data.data(), data.size(), 1000);
+                ASSERT_TRUE(record);
+                ASSERT_EQ(40, record->size);
+                ASSERT_EQ(i, record->tag);
+                ASSERT_EQ(std::vector<uint8_t>(40, i), std::vector<uint8_t>(data.begin(), data.begin() + 40));
+            }
+            ASSERT_FALSE(other.pop(data.data(), data.size(), 10));
+            for (uint8_t i = 0; i < 5; i++) {
+                std::vector<uint8_t> value(40, i);
+                ASSERT_TRUE(other.push(value.data(), value.size(), i, 10));
+            }
+            // full, the push times out
+            ASSERT_FALSE(other.push(data.data(), 40, 0, 10));
+
+            other.setMetadata("key=value");
+
+            ASSERT_EQ("key=value", owner.getMetadata());
+
+            owner.close();
+
+            ASSERT_TRUE(other.isClosed());
+            ASSERT_FALSE(other.push(data.data(), 1, 0, 10));
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(SharedMemoryUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::string name = toUniqueName();
+            SharedMemoryRing owner(name, 256);
+            SharedMemoryRing other(name);
+            std::vector<uint8_t> data(128, 0);
+            uint64_t slow = owner.getTail();
+            uint64_t fast = other.getTail();
+
+            // broadcast: the writer never waits, the oldest records are overwritten
+            for (uint8_t i = 0; i < 8; i++) {
+                uint8_t* reserved = owner.reserve(100);
+                std::fill(reserved, reserved + 40, i);
+                owner.commit(40, 0x81);
+                if (i < 2) {
+                    std::optional<SharedMemoryRing::Record> record = other.read(fast, data.data(), data.size(), 1000);
+                    ASSERT_TRUE(record);
+                    ASSERT_FALSE(record->overrun);
+                    ASSERT_EQ(i, data.front());
+                }
+            }
+
+            std::optional<SharedMemoryRing::Record> record = other.read(slow, data.data(), data.size(), 1000);
+
+            ASSERT_TRUE(record);
+            ASSERT_TRUE(record->overrun);
+            ASSERT_EQ(0x81, record->tag);
+            ASSERT_LT(2, data.front());
+
+            record = other.read(slow, data.data(), 16, 1000);
+
+            ASSERT_TRUE(record);
+            ASSERT_TRUE(record->truncated);
+            ASSERT_EQ(16, record->size);
+
+            owner.close();
+            size_t remaining = 0;
+            while (other.read(slow, data.data(), data.size(), 1000)) {
+                remaining++;
+            }
+
+            // the closed ring is drained and then ends the reads without waiting
+            ASSERT_LT(0, remaining);
+            ASSERT_EQ(7, data.front());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(SharedMemoryUnitTests, test3) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::string name = toUniqueName();
+            std::shared_ptr<IClient> device = ClientFactory::createSimulatedShared({});
+            device->open(device->listDevices().front());
+            SharedMemoryServer::Options options = {};
+            options.inCapacity = 1 << 16;
+            options.outCapacity = 1 << 16;
+            options.readSize = 512;
+            SharedMemoryServer server(device, name, options);
+            std::shared_ptr<IClient> client1 = ClientFactory::createSharedMemoryShared(name);
+            std::shared_ptr<IClient> client2 = ClientFactory::createSharedMemoryShared(name);
+
+            ASSERT_TRUE(client1->listDevices().empty());
+
+            server.start();
+            std::vector<std::map<std::string, uint16_t>> devices = client1->listDevices();
+
+            ASSERT_EQ(1, devices.size());
+            ASSERT_EQ(device->getDevice(), devices.front());
+            ASSERT_EQ("SIM1", client1->getStringDescriptor(devices.front(), StringDescriptor::SERIAL_NUMBER).value_or(""));
+
+            // both clients open the device the server claimed
+            client1->open(devices.front());
+            client2->open(client2->listDevices().front());
+            client1->bulkWrite({1, 2, 3}, 0x01, 1000);
+
+            ASSERT_EQ(std::vector<uint8_t>({1, 2, 3}), client1->bulkRead(0x81, 1000, 512));
+            ASSERT_EQ(std::vector<uint8_t>({1, 2, 3}), client2->bulkRead(0x81, 1000, 512));
+            ASSERT_THROW(client2->bulkRead(0x81, 10, 512), std::runtime_error);
+
+            client2->bulkWrite({4, 5}, 0x01, 1000);
+
+            ASSERT_EQ(std::vector<uint8_t>({4, 5}), client1->bulkRead(0x81, 1000, 512));
+            ASSERT_EQ(std::vector<uint8_t>({4, 5}), client2->bulkRead(0x81, 1000, 512));
+
+            server.stop();
+
+            ASSERT_THROW(client1->bulkRead(0x81, 1000, 512), std::runtime_error);
+            ASSERT_TRUE(client2->listDevices().empty());
+
+            SharedMemoryServer::Stats stats = server.getStats();
+
+            ASSERT_EQ(5, stats.bytesRead);
+            ASSERT_EQ(5, stats.bytesWritten);
+            ASSERT_EQ(2, stats.writeCount);
+            ASSERT_EQ(0, stats.writeErrors);
+
+            client1->close();
+            client2->close();
+            device->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(SharedMemoryUnitTests, test4) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            // a server process creates its rings and crashes once a client opened the device, the rings stay linked
+            std::string name = toUniqueName();
+            int ready[2] = {};
+            int crash[2] = {};
+            ASSERT_EQ(0, pipe(ready));
+            ASSERT_EQ(0, pipe(crash));
+            pid_t server = fork();
+            if (server == 0) {
+                // '_exit' skips the destructors, nothing is closed or unlinked
+                SharedMemoryRing inRing(SharedMemoryServer::toInName(name, 0x81), 1 << 12);
+                SharedMemoryRing outRing(SharedMemoryServer::toOutName(name), 1 << 12);
+                outRing.setMetadata("address=1\nbus=1\nport=1\nproduct=2\nvendor=1\ninEndpoints=129\nreadSize=512\n");
+                char value = 0;
+                ::write(ready[1], &value, 1);
+                ::read(crash[0], &value, 1);
+                _exit(0);
+            }
+            char value = 0;
+            ASSERT_EQ(1, ::read(ready[0], &value, 1));
+
+            std::shared_ptr<IClient> client = ClientFactory::createSharedMemoryShared(name);
+            std::vector<std::map<std::string, uint16_t>> devices = client->listDevices();
+
+            ASSERT_EQ(1, devices.size());
+
+            client->open(devices.front());
+            ::write(crash[1], &value, 1);
+            waitpid(server, nullptr, 0);
+            for (int file : {ready[0], ready[1], crash[0], crash[1]}) {
+                ::close(file);
+            }
+
+            ASSERT_FALSE(SharedMemoryRing(SharedMemoryServer::toOutName(name)).isOwnerAlive());
+
+            std::vector<std::string> stackTrace = {};
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            try {
+                client->bulkRead(0x81, 0, 512);
+            } catch (const std::exception& e) {
+                stackTrace = TestUtils::toStackTrace(e);
+            }
+
+            ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+            ASSERT_TRUE(std::ranges::any_of(stackTrace, [](const std::string& line) { return line.find("LIBUSB_ERROR_NO_DEVICE") != std::string::npos; }));
+            ASSERT_TRUE(client->listDevices().empty());
+
+            client->close();
+
+            ASSERT_THROW(client->open(devices.front()), std::runtime_error);
+
+            // rings created under the same names replace the stale ones and unlink them on destruction
+            SharedMemoryRing inRing(SharedMemoryServer::toInName(name, 0x81), 64);
+            SharedMemoryRing outRing(SharedMemoryServer::toOutName(name), 64);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(SharedMemoryUnitTests, test5) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::string name = toUniqueName();
+            std::shared_ptr<IClient> device = ClientFactory::createSimulatedShared({});
+            device->open(device->listDevices().front());
+            SharedMemoryServer::Options options = {};
+            options.inCapacity = 1 << 16;
+            options.outCapacity = 1 << 16;
+            options.readSize = 512;
+            SharedMemoryServer server(device, name, options);
+            std::shared_ptr<IClient> client = ClientFactory::createSharedMemoryShared(name);
+
+            server.start();
+            client->open(client->listDevices().front());
+
+            // closing the client ends a read blocked without a timeout, the rings stay mapped until it returns
+            std::vector<std::string> stackTrace = {};
+            std::thread reader([&client, &stackTrace]() {
+                try {
+                    client->bulkRead(0x81, 0, 512);
+                } catch (const std::exception& e) {
+                    stackTrace = TestUtils::toStackTrace(e);
+                }
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            client->close();
+            reader.join();
+
+            ASSERT_TRUE(std::ranges::any_of(stackTrace, [](const std::string& line) { return line.find("LIBUSB_ERROR_NO_DEVICE") != std::string::npos; }));
+            ASSERT_FALSE(server.getError());
+
+            // the served device goes away under the server, its reader thread fails and reports it
+            device->close();
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while (!server.getError() && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            ASSERT_TRUE(server.getError());
+            ASSERT_THROW(server.stop(), std::runtime_error);
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+#endif
+
+}
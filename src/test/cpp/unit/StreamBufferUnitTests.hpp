@@ -0,0 +1,139 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <istream>
+#include <ostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/StreamBuffer.hpp"
+
+namespace exqudens::usb {
+
+    class StreamBufferUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "StreamBufferUnitTests";
+
+    };
+
+    TEST_F(StreamBufferUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared({});
+            client->open(client->listDevices().front());
+            std::vector<std::string> stackTrace = {};
+
+            {
+                StreamBuffer buffer(client, 1, 10);
+                std::ostream output(&buffer);
+                std::istream input(&buffer);
+
+                for (char c : std::string("hello world ")) {
+                    output.put(c);
+                }
+
+                ASSERT_EQ(0, buffer.getWriteCount());
+
+                output << 42 << '\n';
+                output.flush();
+
+                ASSERT_EQ(1, buffer.getWriteCount());
+                ASSERT_EQ('h', buffer.peek());
+
+                std::vector<uint8_t> bytes = buffer.readExact(5);
+
+                ASSERT_EQ(std::string("hello"), std::string(bytes.begin(), bytes.end()));
+                ASSERT_EQ(1, buffer.getReadCount());
+
+                std::string word = "";
+                int number = 0;
+                input >> word >> number;
+                EXQUDENS_LOG_INFO(LOGGER_ID) << "word: '" << word << "' number: " << number;
+
+                ASSERT_EQ(std::string("world"), word);
+                ASSERT_EQ(42, number);
+                ASSERT_EQ(1, buffer.getReadCount());
+
+                ASSERT_EQ('\n', input.get());
+
+                try {
+                    buffer.readExact(1);
+                } catch (const std::exception& e) {
+                    stackTrace = TestUtils::toStackTrace(e);
+                }
+
+                ASSERT_FALSE(stackTrace.empty());
+
+                output << "tail";
+            }
+
+            std::vector<uint8_t> bytes = client->bulkRead(1, 10, 64);
+
+            ASSERT_EQ(std::string("tail"), std::string(bytes.begin(), bytes.end()));
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+    TEST_F(StreamBufferUnitTests, test2) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::vector<uint8_t> written = {};
+            SimulatedTransport::Options options = {};
+            options.transform = [&written](uint8_t endpoint, const std::vector<uint8_t>& value) {
+                written.insert(written.end(), value.begin(), value.end());
+                return std::vector<uint8_t> {};
+            };
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared(options);
+            client->open(client->listDevices().front());
+
+            {
+                StreamBuffer buffer(client, 0x81, 0x01, 10, 100, 64);
+                std::ostream output(&buffer);
+
+                for (size_t i = 0; i < 1000; i++) {
+                    output.put((char) (i % 256));
+                }
+                EXQUDENS_LOG_INFO(LOGGER_ID) << "writeCount: " << buffer.getWriteCount();
+
+                ASSERT_TRUE(buffer.getWriteCount() > 0);
+                ASSERT_TRUE(buffer.getWriteCount() < 10);
+            }
+
+            ASSERT_EQ(1000, written.size());
+            for (size_t i = 0; i < written.size(); i++) {
+                ASSERT_EQ((uint8_t) (i % 256), written.at(i));
+            }
+
+            client->close();
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
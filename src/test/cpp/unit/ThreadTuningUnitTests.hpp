@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ThreadTuning.hpp"
+#include "exqudens/usb/LibusbTransport.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+
+namespace exqudens::usb {
+
+    class ThreadTuningUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "ThreadTuningUnitTests";
+
+    };
+
+    TEST_F(ThreadTuningUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            ASSERT_TRUE(ThreadTuning::isEmpty({}));
+            ASSERT_TRUE(ThreadTuning::apply({}).empty());
+
+            std::thread thread([]() {
+                ThreadOptions options = {};
+                options.cpus = {0};
+                options.policy = ThreadOptions::Policy::FIFO;
+                options.priority = 1000;
+                std::vector<std::string> errors = ThreadTuning::apply(options);
+                // real-time scheduling needs privileges, the outcome is reported either way
+                for (const std::string& error : errors) {
+                    EXQUDENS_LOG_INFO(LOGGER_ID) << "error: '" << error << "'";
+                    ASSERT_EQ(0, error.find("policy: "));
+                }
+            });
+            thread.join();
+
+            ThreadOptions options = {};
+            options.cpus = {1000000};
+            ASSERT_EQ(1, ThreadTuning::apply(options).size());
+
+            options.strict = true;
+            ASSERT_THROW(ThreadTuning::apply(options), std::runtime_error);
+
+            // the transport tunes only threads opting in
+            options.strict = false;
+            LibusbTransport transport(options);
+
+            ASSERT_TRUE(transport.getThreadErrors().empty());
+            ASSERT_EQ(1, transport.tuneCurrentThread().size());
+            ASSERT_EQ(1, transport.getThreadErrors().size());
+
+            // reachable through the client, clients of other transports have nothing to tune
+            std::shared_ptr<IClient> client = ClientFactory::createShared(false, false, {}, options);
+            std::shared_ptr<IClient> simulated = ClientFactory::createSimulatedShared({});
+
+            ASSERT_EQ(1, client->tuneCurrentThread().size());
+            ASSERT_EQ(1, client->getThreadErrors().size());
+            ASSERT_TRUE(simulated->tuneCurrentThread().empty());
+            ASSERT_TRUE(simulated->getThreadErrors().empty());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <memory>
+#include <thread>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <exqudens/Log.hpp>
+
+#include "TestUtils.hpp"
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/Client.hpp"
+#include "exqudens/usb/TransferTimeline.hpp"
+
+namespace exqudens::usb {
+
+    class TransferTimelineUnitTests: public testing::Test {
+
+        public:
+
+            inline static const char* LOGGER_ID = "TransferTimelineUnitTests";
+
+    };
+
+    TEST_F(TransferTimelineUnitTests, test1) {
+        try {
+            std::string testGroup = testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
+            std::string testCase = testing::UnitTest::GetInstance()->current_test_info()->name();
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' bgn";
+
+            std::shared_ptr<IClient> client = ClientFactory::createSimulatedShared({});
+            client->open(client->listDevices().front());
+            client->bulkWrite({1}, 0x01, 1000);
+            client->bulkRead(0x81, 1000, 512);
+
+            ASSERT_FALSE(client->getLastTransfer());
+            ASSERT_TRUE(client->getTimeline().empty());
+
+            client->setTimelineCapacity(2);
+            for (uint8_t i = 0; i < 3; i++) {
+                client->bulkWrite({i, i}, 0x01, 1000);
+                client->bulkRead(0x81, 1000, 512);
+            }
+            std::optional<TransferInfo> last = client->getLastTransfer();
+
+            ASSERT_TRUE(last);
+            ASSERT_EQ(6, last->sequence);
+            ASSERT_EQ(0x81, last->endpoint);
+            ASSERT_EQ(512, last->requested);
+            ASSERT_EQ(2, last->transferred);
+            ASSERT_EQ(0, last->libusbError);
+            ASSERT_LE(last->submittedAt, last->completedAt);
+
+            ASSERT_THROW(client->bulkRead(0x81, 10, 512), std::runtime_error);
+
+            // two kept per endpoint, in submit order, the timed out read replaced the oldest read
+            std::vector<TransferInfo> timeline = client->getTimeline();
+
+            ASSERT_EQ(4, timeline.size());
+            ASSERT_EQ(std::vector<uint64_t>({3, 5, 6, 7}), std::vector<uint64_t>({timeline.at(0).sequence, timeline.at(1).sequence, timeline.at(2).sequence, timeline.at(3).sequence}));
+            ASSERT_EQ(0x01, timeline.at(1).endpoint);
+            ASSERT_EQ(-7, timeline.at(3).libusbError);
+            ASSERT_EQ(0, timeline.at(3).transferred);
+            for (size_t i = 1; i < timeline.size(); i++) {
+                ASSERT_LE(timeline.at(i - 1).completedAt, timeline.at(i).submittedAt);
+            }
+
+            // another thread has no last transfer of its own
+            std::optional<TransferInfo> other = {};
+            std::thread([&client, &other]() { other = client->getLastTransfer(); }).join();
+
+            ASSERT_FALSE(other);
+
+            std::string trace = TransferTimeline::toChromeTrace(timeline);
+
+            ASSERT_THAT(trace, testing::StartsWith("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+            ASSERT_THAT(trace, testing::HasSubstr("{\"name\":\"OUT 0x01\",\"cat\":\"usb\",\"id\":5,\"pid\":1,\"tid\":1,\"ph\":\"b\","));
+            ASSERT_THAT(trace, testing::HasSubstr("{\"name\":\"IN 0x81\",\"cat\":\"usb\",\"id\":7,\"pid\":1,\"tid\":129,\"ph\":\"b\","));
+            ASSERT_THAT(trace, testing::HasSubstr("\"args\":{\"result\":\"LIBUSB_ERROR_TIMEOUT\",\"transferred\":0,\"libusbError\":-7}}]}"));
+            auto count = [&trace](const std::string& value) {
+                size_t result = 0;
+                for (size_t i = trace.find(value); i != std::string::npos; i = trace.find(value, i + 1)) {
+                    result++;
+                }
+                return result;
+            };
+
+            ASSERT_EQ(4, count("\"ph\":\"b\""));
+            ASSERT_EQ(4, count("\"ph\":\"e\""));
+
+            client->setTimelineCapacity(0);
+            client->bulkWrite({1}, 0x01, 1000);
+
+            ASSERT_FALSE(client->getLastTransfer());
+            ASSERT_TRUE(client->getTimeline().empty());
+
+            client->close();
+
+            // a client constructed at the address of a destroyed one does not see its last transfer
+            std::optional<Client> reused = {};
+            reused.emplace(true, true, nullptr, std::make_shared<SimulatedTransport>(SimulatedTransport::Options {}));
+            reused->setTimelineCapacity(1);
+            reused->open(reused->listDevices().front());
+            reused->bulkWrite({1}, 0x01, 1000);
+
+            ASSERT_TRUE(reused->getLastTransfer());
+
+            reused.reset();
+            reused.emplace(true, true, nullptr, std::make_shared<SimulatedTransport>(SimulatedTransport::Options {}));
+            reused->setTimelineCapacity(1);
+
+            ASSERT_FALSE(reused->getLastTransfer());
+
+            EXQUDENS_LOG_INFO(LOGGER_ID) << "'" << testGroup << "." << testCase << "' end";
+        } catch (const std::exception& e) {
+            std::string errorMessage = TestUtils::toString(e);
+            EXQUDENS_LOG_ERROR(LOGGER_ID) << errorMessage;
+            FAIL() << errorMessage;
+        }
+    }
+
+}
@@ -0,0 +1,65 @@
+#include <stdexcept>
+
+#include "CommandLine.hpp"
+
+namespace exqudens::usb {
+
+    std::map<std::string, std::string> CommandLine::toArgs(int argc, char** argv) {
+        std::map<std::string, std::string> result = {};
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (!arg.starts_with("--")) {
+                throw std::runtime_error("unexpected argument: '" + arg + "'");
+            }
+            size_t separator = arg.find('=');
+            if (separator == std::string::npos) {
+                result[arg.substr(2)] = "";
+            } else {
+                result[arg.substr(2, separator - 2)] = arg.substr(separator + 1);
+            }
+        }
+        return result;
+    }
+
+    size_t CommandLine::toNumber(const std::map<std::string, std::string>& args, const std::string& name, size_t defaultValue) {
+        auto arg = args.find(name);
+        if (arg == args.end()) {
+            return defaultValue;
+        }
+        try {
+            return std::stoull(arg->second, nullptr, 0);
+        } catch (...) {
+            throw std::runtime_error("'--" + name + "': '" + arg->second + "' is not a number");
+        }
+    }
+
+    std::vector<size_t> CommandLine::toNumbers(const std::map<std::string, std::string>& args, const std::string& name, const std::string& defaultValue) {
+        auto arg = args.find(name);
+        std::string value = arg == args.end() ? defaultValue : arg->second;
+        std::vector<size_t> result = {};
+        size_t begin = 0;
+        while (begin <= value.size()) {
+            size_t end = value.find(',', begin);
+            if (end == std::string::npos) {
+                end = value.size();
+            }
+            std::map<std::string, std::string> element = {{name, value.substr(begin, end - begin)}};
+            result.emplace_back(toNumber(element, name, 0));
+            begin = end + 1;
+        }
+        return result;
+    }
+
+    std::vector<std::string> CommandLine::toStackTrace(const std::exception& exception, std::vector<std::string> previous) {
+        previous.emplace_back(exception.what());
+        try {
+            std::rethrow_if_nested(exception);
+            return previous;
+        } catch (const std::exception& e) {
+            return toStackTrace(e, previous);
+        } catch (...) {
+            return previous;
+        }
+    }
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+#include <exception>
+
+namespace exqudens::usb {
+
+    /*!
+    * Argument parsing and error output shared by the command line applications.
+    * Errors carry the offending option only, they are printed to the user as is.
+    */
+    class CommandLine {
+
+        public:
+
+            /*!
+            * @return Options '--name=value' and '--name' (empty value) by name without the dashes.
+            *
+            * @throws std::runtime_error On an argument not starting with '--'.
+            */
+            static std::map<std::string, std::string> toArgs(int argc, char** argv);
+
+            /*!
+            * @return The decimal, hex ('0x') or octal value of option 'name', 'defaultValue' if it is not given.
+            *
+            * @throws std::runtime_error If the value is not a number.
+            */
+            static size_t toNumber(const std::map<std::string, std::string>& args, const std::string& name, size_t defaultValue);
+
+            /*!
+            * @return The comma separated numbers of option 'name', parsed from 'defaultValue' if it is not given.
+            *
+            * @throws std::runtime_error If a value is not a number.
+            */
+            static std::vector<size_t> toNumbers(const std::map<std::string, std::string>& args, const std::string& name, const std::string& defaultValue);
+
+            /*!
+            * @return The messages of the nested exception chain, outermost first.
+            */
+            static std::vector<std::string> toStackTrace(const std::exception& exception, std::vector<std::string> previous = {});
+
+    };
+
+}
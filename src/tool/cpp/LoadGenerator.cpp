@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <mutex>
+#include <condition_variable>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "LoadGenerator.hpp"
+
+#define CALL_INFO std::string(__FUNCTION__) + "(" + std::filesystem::path(__FILE__).filename().string() + ":" + std::to_string(__LINE__) + ")"
+
+namespace exqudens::usb {
+
+    namespace {
+
+        /*!
+        * Hands out transfers until 'Options::count' or 'Options::duration' is reached.
+        */
+        class Limit {
+
+            private:
+
+                size_t count = 0;
+                std::chrono::steady_clock::time_point end = std::chrono::steady_clock::time_point::max();
+                std::atomic<size_t> issued = 0;
+
+            public:
+
+                explicit Limit(const LoadGenerator::Options& options): count(options.count) {
+                    if (options.duration.count() > 0) {
+                        end = std::chrono::steady_clock::now() + options.duration;
+                    }
+                }
+
+                bool next() {
+                    size_t index = issued++;
+                    return (count == 0 || index < count) && std::chrono::steady_clock::now() < end;
+                }
+
+        };
+
+        uint64_t toNanoseconds(const std::chrono::steady_clock::time_point& start) {
+            return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        double toPercentile(const std::vector<uint64_t>& sorted, double percentile) {
+            if (sorted.empty()) {
+                return 0;
+            }
+            size_t index = (size_t) (percentile / 100.0 * (double) (sorted.size() - 1) + 0.5);
+            return (double) sorted.at(index) / 1000.0;
+        }
+
+    }
+
+    LoadGenerator::LoadGenerator(const std::shared_ptr<IClient>& client): client(client) {
+        try {
+            if (!this->client) {
+                throw std::runtime_error(CALL_INFO + ": client is null!");
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    LoadGenerator::Result LoadGenerator::run(const Options& options) {
+        try {
+            if (options.size == 0 || options.size > (size_t) INT32_MAX) {
+                throw std::runtime_error(CALL_INFO + ": size: " + std::to_string(options.size) + " out of range");
+            }
+            if (options.depth == 0) {
+                throw std::runtime_error(CALL_INFO + ": depth is zero!");
+            }
+            if (options.count == 0 && options.duration.count() <= 0) {
+                throw std::runtime_error(CALL_INFO + ": count and duration are unlimited!");
+            }
+
+            std::vector<std::vector<uint64_t>> latencies(options.depth);
+            size_t transfers = 0;
+            size_t bytes = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            if (options.workload == Workload::ECHO) {
+                runEcho(options, latencies, transfers);
+                bytes = transfers * options.size;
+            } else {
+                runFlood(options, latencies, transfers, bytes);
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return toResult(options, latencies, transfers, bytes, seconds);
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<LoadGenerator::Result> LoadGenerator::sweepSize(const Options& options, const std::vector<size_t>& sizes) {
+        try {
+            std::vector<Result> results = {};
+            for (size_t size : sizes) {
+                Options runOptions = options;
+                runOptions.size = size;
+                results.emplace_back(run(runOptions));
+            }
+            return results;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::vector<LoadGenerator::Result> LoadGenerator::sweepDepth(const Options& options, const std::vector<size_t>& depths) {
+        try {
+            std::vector<Result> results = {};
+            for (size_t depth : depths) {
+                Options runOptions = options;
+                runOptions.depth = depth;
+                results.emplace_back(run(runOptions));
+            }
+            return results;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string LoadGenerator::toString(Workload value) {
+        try {
+            switch (value) {
+                case Workload::ECHO:
+                    return "echo";
+                case Workload::WRITE:
+                    return "write";
+                case Workload::READ:
+                    return "read";
+            }
+            throw std::runtime_error(CALL_INFO + ": unsupported workload: " + std::to_string((int) value));
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    LoadGenerator::Workload LoadGenerator::toWorkload(const std::string& value) {
+        try {
+            for (Workload workload : {Workload::ECHO, Workload::WRITE, Workload::READ}) {
+                if (toString(workload) == value) {
+                    return workload;
+                }
+            }
+            throw std::runtime_error(CALL_INFO + ": unsupported workload: '" + value + "'");
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string LoadGenerator::toText(const std::vector<Result>& results) {
+        try {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(1);
+            out << std::left << std::setw(9) << "workload" << std::right
+                << std::setw(10) << "size" << std::setw(7) << "depth"
+                << std::setw(11) << "transfers" << std::setw(11) << "MB/s" << std::setw(13) << "transfers/s"
+                << std::setw(10) << "min us" << std::setw(10) << "p50 us" << std::setw(10) << "p90 us"
+                << std::setw(10) << "p99 us" << std::setw(11) << "p99.9 us" << std::setw(10) << "max us" << std::endl;
+            for (const Result& result : results) {
+                out << std::left << std::setw(9) << toString(result.workload) << std::right
+                    << std::setw(10) << result.size << std::setw(7) << result.depth
+                    << std::setw(11) << result.transfers << std::setw(11) << result.megabytesPerSecond << std::setw(13) << result.transfersPerSecond
+                    << std::setw(10) << result.min << std::setw(10) << result.p50 << std::setw(10) << result.p90
+                    << std::setw(10) << result.p99 << std::setw(11) << result.p999 << std::setw(10) << result.max << std::endl;
+            }
+            return out.str();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    std::string LoadGenerator::toJson(const std::vector<Result>& results) {
+        try {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(3);
+            out << "[" << std::endl;
+            for (size_t i = 0; i < results.size(); i++) {
+                const Result& result = results.at(i);
+                out << "  {"
+                    << "\"workload\": \"" << toString(result.workload) << "\", "
+                    << "\"size\": " << result.size << ", "
+                    << "\"depth\": " << result.depth << ", "
+                    << "\"transfers\": " << result.transfers << ", "
+                    << "\"bytes\": " << result.bytes << ", "
+                    << "\"seconds\": " << result.seconds << ", "
+                    << "\"megabytesPerSecond\": " << result.megabytesPerSecond << ", "
+                    << "\"transfersPerSecond\": " << result.transfersPerSecond << ", "
+                    << "\"latencyMicroseconds\": {"
+                    << "\"min\": " << result.min << ", "
+                    << "\"p50\": " << result.p50 << ", "
+                    << "\"p90\": " << result.p90 << ", "
+                    << "\"p99\": " << result.p99 << ", "
+                    << "\"p99.9\": " << result.p999 << ", "
+                    << "\"max\": " << result.max
+                    << "}}" << (i + 1 < results.size() ? "," : "") << std::endl;
+            }
+            out << "]" << std::endl;
+            return out.str();
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LoadGenerator::runEcho(const Options& options, std::vector<std::vector<uint64_t>>& latencies, size_t& transfers) {
+        try {
+            Limit limit(options);
+            std::vector<uint8_t> value(options.size, 0xA5);
+            std::vector<uint8_t> response(options.size);
+
+            // reads until the whole message is back, a device may answer in several packets
+            auto receive = [this, &options, &response]() {
+                size_t received = 0;
+                while (received < response.size()) {
+                    Buffer tail(response.data() + received, response.size() - received, false, {});
+                    size_t size = client->bulkRead(tail, options.endpoint, options.timeout);
+                    if (size == 0) {
+                        throw std::runtime_error(CALL_INFO + ": empty response after " + std::to_string(received) + " bytes");
+                    }
+                    received += size;
+                }
+            };
+
+            if (options.depth == 1) {
+                while (limit.next()) {
+                    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    client->bulkWrite(value, options.endpoint, options.timeout);
+                    receive();
+                    latencies.at(0).emplace_back(toNanoseconds(start));
+                    transfers++;
+                }
+                return;
+            }
+
+            // responses come back in write order, so the oldest start time belongs to the next response
+            std::mutex mutex = {};
+            std::condition_variable condition = {};
+            std::deque<std::chrono::steady_clock::time_point> inFlight = {};
+            bool writing = true;
+            std::exception_ptr error = nullptr;
+
+            std::thread writer([this, &options, &limit, &value, &mutex, &condition, &inFlight, &writing, &error]() {
+                try {
+                    while (limit.next()) {
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            condition.wait(lock, [&options, &inFlight, &error]() { return inFlight.size() < options.depth || error; });
+                            if (error) {
+                                break;
+                            }
+                            inFlight.emplace_back(std::chrono::steady_clock::now());
+                        }
+                        condition.notify_all();
+                        client->bulkWrite(value, options.endpoint, options.timeout);
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    writing = false;
+                }
+                condition.notify_all();
+            });
+
+            try {
+                while (true) {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        condition.wait(lock, [&inFlight, &writing]() { return !inFlight.empty() || !writing; });
+                        if (inFlight.empty() || error) {
+                            break;
+                        }
+                    }
+                    receive();
+                    uint64_t latency = 0;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        latency = toNanoseconds(inFlight.front());
+                        inFlight.pop_front();
+                    }
+                    condition.notify_all();
+                    latencies.at(transfers % options.depth).emplace_back(latency);
+                    transfers++;
+                }
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                condition.notify_all();
+            }
+
+            writer.join();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    void LoadGenerator::runFlood(const Options& options, std::vector<std::vector<uint64_t>>& latencies, size_t& transfers, size_t& bytes) {
+        try {
+            Limit limit(options);
+            std::vector<size_t> threadTransfers(options.depth, 0);
+            std::vector<size_t> threadBytes(options.depth, 0);
+            std::vector<std::exception_ptr> errors(options.depth, nullptr);
+
+            auto work = [this, &options, &limit, &latencies, &threadTransfers, &threadBytes, &errors](size_t index) {
+                try {
+                    std::vector<uint8_t> data(options.size, 0xA5);
+                    Buffer buffer(data.data(), data.size(), false, {});
+                    buffer.setSize(data.size());
+                    std::vector<uint64_t>& threadLatencies = latencies.at(index);
+                    while (limit.next()) {
+                        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                        size_t size = options.workload == Workload::WRITE
+                            ? client->bulkWrite(buffer, options.endpoint, options.timeout)
+                            : client->bulkRead(buffer, options.endpoint, options.timeout);
+                        threadLatencies.emplace_back(toNanoseconds(start));
+                        threadTransfers.at(index)++;
+                        threadBytes.at(index) += size;
+                    }
+                } catch (...) {
+                    errors.at(index) = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> threads = {};
+            for (size_t i = 1; i < options.depth; i++) {
+                threads.emplace_back(work, i);
+            }
+            work(0);
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            for (size_t i = 0; i < options.depth; i++) {
+                if (errors.at(i)) {
+                    std::rethrow_exception(errors.at(i));
+                }
+                transfers += threadTransfers.at(i);
+                bytes += threadBytes.at(i);
+            }
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+    LoadGenerator::Result LoadGenerator::toResult(const Options& options, std::vector<std::vector<uint64_t>>& latencies, size_t transfers, size_t bytes, double seconds) {
+        try {
+            std::vector<uint64_t> sorted = {};
+            for (std::vector<uint64_t>& threadLatencies : latencies) {
+                sorted.insert(sorted.end(), threadLatencies.begin(), threadLatencies.end());
+                threadLatencies = {};
+            }
+            std::ranges::sort(sorted);
+
+            Result result = {};
+            result.workload = options.workload;
+            result.size = options.size;
+            result.depth = options.depth;
+            result.transfers = transfers;
+            result.bytes = bytes;
+            result.seconds = seconds;
+            if (seconds > 0) {
+                result.megabytesPerSecond = (double) bytes / 1000000.0 / seconds;
+                result.transfersPerSecond = (double) transfers / seconds;
+            }
+            result.min = toPercentile(sorted, 0);
+            result.p50 = toPercentile(sorted, 50);
+            result.p90 = toPercentile(sorted, 90);
+            result.p99 = toPercentile(sorted, 99);
+            result.p999 = toPercentile(sorted, 99.9);
+            result.max = toPercentile(sorted, 100);
+            return result;
+        } catch (...) {
+            std::throw_with_nested(std::runtime_error(CALL_INFO));
+        }
+    }
+
+}
+
+#undef CALL_INFO
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include "exqudens/usb/IClient.hpp"
+
+namespace exqudens::usb {
+
+    /*!
+    * Drives bulk transfers of one open client and measures throughput and per-transfer latency.
+    * Transfers are synchronous, 'Options::depth' transfers are kept in flight by that many threads
+    * (a writer and a reader thread with at most 'depth' unanswered messages for 'ECHO').
+    */
+    class LoadGenerator {
+
+        public:
+
+            enum class Workload {
+                ECHO, //!< Write 'size' bytes, read 'size' bytes back.
+                WRITE, //!< Write flood on the OUT endpoint.
+                READ //!< Read flood on the IN endpoint.
+            };
+
+            struct Options {
+                Workload workload = Workload::ECHO;
+                uint8_t endpoint = 0x01; //!< Endpoint number, the direction is set per transfer.
+                size_t size = 512; //!< Bytes per transfer.
+                size_t depth = 1; //!< Transfers in flight.
+                size_t count = 10000; //!< Transfers per run, '0' for unlimited.
+                std::chrono::milliseconds duration = std::chrono::milliseconds(0); //!< Run length, '0' for unlimited.
+                uint32_t timeout = 1000; //!< Per transfer.
+            };
+
+            struct Result {
+                Workload workload = Workload::ECHO;
+                size_t size = 0;
+                size_t depth = 0;
+                size_t transfers = 0; //!< Completed transfers, a round trip for 'ECHO'.
+                size_t bytes = 0; //!< Payload bytes, one direction.
+                double seconds = 0;
+                double megabytesPerSecond = 0;
+                double transfersPerSecond = 0;
+                double min = 0; //!< Latency in microseconds.
+                double p50 = 0;
+                double p90 = 0;
+                double p99 = 0;
+                double p999 = 0;
+                double max = 0;
+            };
+
+        private:
+
+            std::shared_ptr<IClient> client = nullptr;
+
+        public:
+
+            explicit LoadGenerator(const std::shared_ptr<IClient>& client);
+
+            /*!
+            * @throws std::runtime_error
+            */
+            Result run(const Options& options);
+
+            /*!
+            * Runs 'options' once per size.
+            */
+            std::vector<Result> sweepSize(const Options& options, const std::vector<size_t>& sizes);
+
+            /*!
+            * Runs 'options' once per queue depth.
+            */
+            std::vector<Result> sweepDepth(const Options& options, const std::vector<size_t>& depths);
+
+            static std::string toString(Workload value);
+
+            static Workload toWorkload(const std::string& value);
+
+            static std::string toText(const std::vector<Result>& results);
+
+            static std::string toJson(const std::vector<Result>& results);
+
+        private:
+
+            void runEcho(const Options& options, std::vector<std::vector<uint64_t>>& latencies, size_t& transfers);
+
+            void runFlood(const Options& options, std::vector<std::vector<uint64_t>>& latencies, size_t& transfers, size_t& bytes);
+
+            static Result toResult(const Options& options, std::vector<std::vector<uint64_t>>& latencies, size_t transfers, size_t bytes, double seconds);
+
+    };
+
+}
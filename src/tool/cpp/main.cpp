@@ -0,0 +1,153 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <iostream>
+
+#include "exqudens/usb/ClientFactory.hpp"
+#include "exqudens/usb/versions.hpp"
+
+#include "CommandLine.hpp"
+#include "LoadGenerator.hpp"
+
+using exqudens::usb::ClientFactory;
+using exqudens::usb::CommandLine;
+using exqudens::usb::DeviceFilter;
+using exqudens::usb::IClient;
+using exqudens::usb::LoadGenerator;
+using exqudens::usb::SimulatedTransport;
+
+static const char* USAGE = R"(Usage: load-app [options]
+
+Runs a bulk transfer workload against the first device matching the filter.
+
+Device:
+  --simulated                 Use an in-process simulated device instead of libusb.
+  --simulated-latency=<us>    Latency added to every simulated transfer.
+  --simulated-bandwidth=<B/s> Simulated bandwidth, '0' for unlimited.
+  --vendor=<id>               Vendor id, e.g. '0x0484'.
+  --product=<id>              Product id.
+  --bus=<number>              Bus number.
+  --serial=<string>           Serial number.
+  --interface=<number>        Interface to claim, default '0'.
+
+Workload:
+  --workload=<echo|write|read> Round trip, write flood or read flood, default 'echo'.
+  --sweep=<size|depth>        Repeats the workload for every '--sizes' or '--depths' value.
+  --endpoint=<number>         Endpoint number, default '1'.
+  --size=<bytes>              Bytes per transfer, default '512'.
+  --sizes=<a,b,...>           Default '64,512,4096,16384,65536'.
+  --depth=<number>            Transfers in flight, default '1'.
+  --depths=<a,b,...>          Default '1,2,4,8'.
+  --count=<number>            Transfers per run, '0' for unlimited, default '10000' or '0' with '--duration'.
+  --duration=<ms>             Run length, '0' for unlimited, default '0'.
+                              One of '--count' and '--duration' must bound the run.
+  --timeout=<ms>              Per transfer, default '1000'.
+
+Output:
+  --format=<text|json>        Default 'text'.
+  --help
+)";
+
+static std::shared_ptr<IClient> createClient(const std::map<std::string, std::string>& args, LoadGenerator::Workload workload) {
+    if (!args.contains("simulated")) {
+        return ClientFactory::createShared(true, true);
+    }
+    SimulatedTransport::Options options = {};
+    options.latency = std::chrono::microseconds(CommandLine::toNumber(args, "simulated-latency", 0));
+    options.bandwidth = CommandLine::toNumber(args, "simulated-bandwidth", 0);
+    if (workload != LoadGenerator::Workload::ECHO) {
+        // one-way workloads must not queue the written data for the IN endpoint
+        options.transform = [](uint8_t, const std::vector<uint8_t>&) {
+            return std::vector<uint8_t>();
+        };
+    }
+    if (workload == LoadGenerator::Workload::READ) {
+        options.source = [](uint8_t, int32_t length) {
+            return std::vector<uint8_t>((size_t) length, 0xA5);
+        };
+    }
+    return ClientFactory::createSimulatedShared(options);
+}
+
+int main(int argc, char** argv) {
+    try {
+        std::map<std::string, std::string> args = CommandLine::toArgs(argc, argv);
+        if (args.contains("help")) {
+            std::cout << USAGE;
+            return 0;
+        }
+
+        LoadGenerator::Options options = {};
+        options.workload = LoadGenerator::toWorkload(args.contains("workload") ? args.at("workload") : "echo");
+        options.endpoint = (uint8_t) CommandLine::toNumber(args, "endpoint", 1);
+        options.size = CommandLine::toNumber(args, "size", options.size);
+        options.depth = CommandLine::toNumber(args, "depth", options.depth);
+        // a run given a duration lasts for it unless a count is given too
+        options.count = CommandLine::toNumber(args, "count", args.contains("duration") ? 0 : options.count);
+        options.duration = std::chrono::milliseconds(CommandLine::toNumber(args, "duration", 0));
+        options.timeout = (uint32_t) CommandLine::toNumber(args, "timeout", options.timeout);
+        if (options.count == 0 && options.duration.count() <= 0) {
+            throw std::runtime_error(args.contains("count") ? "'--count=0' needs a positive '--duration'" : "'--duration=0' needs a positive '--count'");
+        }
+
+        std::string format = args.contains("format") ? args.at("format") : "text";
+        if (format != "text" && format != "json") {
+            throw std::runtime_error("unsupported format: '" + format + "'");
+        }
+
+        DeviceFilter filter = {};
+        if (args.contains("vendor")) {
+            filter.vendors.insert((uint16_t) CommandLine::toNumber(args, "vendor", 0));
+        }
+        if (args.contains("product")) {
+            filter.products.insert((uint16_t) CommandLine::toNumber(args, "product", 0));
+        }
+        if (args.contains("bus")) {
+            filter.bus = (uint16_t) CommandLine::toNumber(args, "bus", 0);
+        }
+        if (args.contains("serial")) {
+            filter.serial = args.at("serial");
+        }
+
+        std::shared_ptr<IClient> client = createClient(args, options.workload);
+        std::vector<std::map<std::string, uint16_t>> devices = client->listDevices(filter);
+        if (devices.empty()) {
+            throw std::runtime_error("no device matches the filter");
+        }
+        client->open(devices.front(), (int32_t) CommandLine::toNumber(args, "interface", 0), {});
+
+        if (format == "text") {
+            std::cout << "version: " << PROJECT_VERSION_MAJOR << "." << PROJECT_VERSION_MINOR << "." << PROJECT_VERSION_PATCH << std::endl;
+            std::cout << "device: " << client->toString(devices.front()) << std::endl;
+        }
+
+        LoadGenerator generator(client);
+        std::vector<LoadGenerator::Result> results = {};
+        std::string sweep = args.contains("sweep") ? args.at("sweep") : "";
+        if (sweep.empty()) {
+            results.emplace_back(generator.run(options));
+        } else if (sweep == "size") {
+            results = generator.sweepSize(options, CommandLine::toNumbers(args, "sizes", "64,512,4096,16384,65536"));
+        } else if (sweep == "depth") {
+            results = generator.sweepDepth(options, CommandLine::toNumbers(args, "depths", "1,2,4,8"));
+        } else {
+            throw std::runtime_error("unsupported sweep: '" + sweep + "'");
+        }
+
+        client->close();
+
+        std::cout << (format == "json" ? LoadGenerator::toJson(results) : LoadGenerator::toText(results));
+        return 0;
+    } catch (const std::exception& e) {
+        for (const std::string& element : CommandLine::toStackTrace(e)) {
+            std::cerr << element << std::endl;
+        }
+        return 1;
+    }
+}
@@ -14,6 +14,7 @@ class ConanConfiguration(ConanFile):
         try:
             self.requires("gtest/1.11.0.0")
             self.requires("exqudens-cpp-log/0.0.1")
+            self.requires("benchmark/1.8.3")
         except Exception as e:
             self.output.error(e)
             raise e